@@ -1,110 +1,105 @@
 #include "alpaca/account.h"
 
-#include "alpaca/json.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
 
 namespace alpaca {
-Status Account::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing account JSON");
-  }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't an account object");
-  }
+namespace {
+constexpr auto kAccountSchema = makeSchema<Account>("an account",
+    {
+        {"account_blocked", &Account::account_blocked},
+        {"account_number", &Account::account_number},
+        {"buying_power", &Account::buying_power},
+        {"cash", &Account::cash},
+        {"created_at", &Account::created_at},
+        {"currency", &Account::currency},
+        {"daytrade_count", &Account::daytrade_count},
+        {"daytrading_buying_power", &Account::daytrading_buying_power},
+        {"equity", &Account::equity},
+        {"id", &Account::id},
+        {"initial_margin", &Account::initial_margin},
+        {"last_equity", &Account::last_equity},
+        {"last_maintenance_margin", &Account::last_maintenance_margin},
+        {"long_market_value", &Account::long_market_value},
+        {"maintenance_margin", &Account::maintenance_margin},
+        {"multiplier", &Account::multiplier},
+        {"pattern_day_trader", &Account::pattern_day_trader},
+        {"portfolio_value", &Account::portfolio_value},
+        {"regt_buying_power", &Account::regt_buying_power},
+        {"short_market_value", &Account::short_market_value},
+        {"shorting_enabled", &Account::shorting_enabled},
+        {"sma", &Account::sma},
+        {"status", &parseEnum<&Account::status>},
+        {"trade_suspended_by_user", &Account::trade_suspended_by_user},
+        {"trading_blocked", &Account::trading_blocked},
+        {"transfers_blocked", &Account::transfers_blocked},
+    });
+
+constexpr auto kAccountConfigurationsSchema = makeSchema<AccountConfigurations>("an account configurations",
+    {
+        {"dtbp_check", &AccountConfigurations::dtbp_check},
+        {"no_shorting", &AccountConfigurations::no_shorting},
+        {"suspend_trade", &AccountConfigurations::suspend_trade},
+        {"trade_confirm_email", &AccountConfigurations::trade_confirm_email},
+    });
+
+constexpr auto kTradeActivitySchema = makeSchema<TradeActivity>("a trade activity",
+    {
+        {"activity_type", &TradeActivity::activity_type},
+        {"cum_qty", &TradeActivity::cum_qty},
+        {"id", &TradeActivity::id},
+        {"leaves_qty", &TradeActivity::leaves_qty},
+        {"order_id", &TradeActivity::order_id},
+        {"price", &TradeActivity::price},
+        {"qty", &TradeActivity::qty},
+        {"side", &TradeActivity::side},
+        {"symbol", &TradeActivity::symbol},
+        {"transaction_time", &TradeActivity::transaction_time},
+        {"type", &TradeActivity::type},
+    });
+
+constexpr auto kNonTradeActivitySchema = makeSchema<NonTradeActivity>("a non-trade activity",
+    {
+        {"activity_type", &NonTradeActivity::activity_type},
+        {"date", &NonTradeActivity::date},
+        {"id", &NonTradeActivity::id},
+        {"net_amount", &NonTradeActivity::net_amount},
+        {"per_share_amount", &NonTradeActivity::per_share_amount},
+        {"qty", &NonTradeActivity::qty},
+        {"symbol", &NonTradeActivity::symbol},
+    });
+} // namespace
 
-  PARSE_BOOL(account_blocked, "account_blocked")
-  PARSE_STRING(account_number, "account_number")
-  PARSE_STRING(buying_power, "buying_power")
-  PARSE_STRING(cash, "cash")
-  PARSE_STRING(created_at, "created_at")
-  PARSE_STRING(currency, "currency")
-  PARSE_INT(daytrade_count, "daytrade_count")
-  PARSE_STRING(daytrading_buying_power, "daytrading_buying_power")
-  PARSE_STRING(equity, "equity")
-  PARSE_STRING(id, "id")
-  PARSE_STRING(initial_margin, "initial_margin")
-  PARSE_STRING(last_equity, "last_equity")
-  PARSE_STRING(last_maintenance_margin, "last_maintenance_margin")
-  PARSE_STRING(long_market_value, "long_market_value")
-  PARSE_STRING(maintenance_margin, "maintenance_margin")
-  PARSE_STRING(multiplier, "multiplier")
-  PARSE_BOOL(pattern_day_trader, "pattern_day_trader")
-  PARSE_STRING(portfolio_value, "portfolio_value")
-  PARSE_STRING(regt_buying_power, "regt_buying_power")
-  PARSE_STRING(short_market_value, "short_market_value")
-  PARSE_BOOL(shorting_enabled, "shorting_enabled")
-  PARSE_STRING(sma, "sma")
-  PARSE_STRING(status, "status")
-  PARSE_BOOL(trade_suspended_by_user, "trade_suspended_by_user")
-  PARSE_BOOL(trading_blocked, "trading_blocked")
-  PARSE_BOOL(transfers_blocked, "transfers_blocked")
+Status Account::fromJSON(const std::string& json) {
+  return kAccountSchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status Account::fromDocument(const rapidjson::Value& d) {
+  return kAccountSchema.read(d, *this);
 }
 
 Status AccountConfigurations::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing account configurations JSON");
-  }
-
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't an account configurations object");
-  }
-
-  PARSE_STRING(dtbp_check, "dtbp_check")
-  PARSE_BOOL(no_shorting, "no_shorting")
-  PARSE_BOOL(suspend_trade, "suspend_trade")
-  PARSE_STRING(trade_confirm_email, "trade_confirm_email")
+  return kAccountConfigurationsSchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status AccountConfigurations::fromDocument(const rapidjson::Value& d) {
+  return kAccountConfigurationsSchema.read(d, *this);
 }
 
 Status TradeActivity::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing trade activity JSON");
-  }
-
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a trade activity object");
-  }
-
-  PARSE_STRING(activity_type, "activity_type")
-  PARSE_STRING(cum_qty, "cum_qty")
-  PARSE_STRING(id, "id")
-  PARSE_STRING(leaves_qty, "leaves_qty")
-  PARSE_STRING(order_id, "order_id")
-  PARSE_STRING(price, "price")
-  PARSE_STRING(qty, "qty")
-  PARSE_STRING(side, "side")
-  PARSE_STRING(symbol, "symbol")
-  PARSE_STRING(transaction_time, "transaction_time")
-  PARSE_STRING(type, "type")
+  return kTradeActivitySchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status TradeActivity::fromDocument(const rapidjson::Value& d) {
+  return kTradeActivitySchema.read(d, *this);
 }
 
 Status NonTradeActivity::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing non-trade activity JSON");
-  }
-
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a non-trade activity object");
-  }
-
-  PARSE_STRING(activity_type, "activity_type")
-  PARSE_STRING(date, "date")
-  PARSE_STRING(id, "id")
-  PARSE_STRING(net_amount, "net_amount")
-  PARSE_STRING(per_share_amount, "per_share_amount")
-  PARSE_STRING(qty, "qty")
-  PARSE_STRING(symbol, "symbol")
+  return kNonTradeActivitySchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status NonTradeActivity::fromDocument(const rapidjson::Value& d) {
+  return kNonTradeActivitySchema.read(d, *this);
 }
 } // namespace alpaca
\ No newline at end of file
@@ -2,10 +2,42 @@
 
 #include <string>
 
+#include "alpaca/decimal.h"
+#include "alpaca/enum.h"
 #include "alpaca/status.h"
+#include "alpaca/symbol.h"
+#include "alpaca/timestamp.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
+/**
+ * @brief The state of an account.
+ */
+enum class AccountStatus {
+  Onboarding,
+  SubmissionFailed,
+  Submitted,
+  AccountUpdated,
+  ApprovalPending,
+  Active,
+  Rejected,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<AccountStatus> {
+  static constexpr EnumName<AccountStatus> kNames[] = {
+      {"ONBOARDING", AccountStatus::Onboarding},
+      {"SUBMISSION_FAILED", AccountStatus::SubmissionFailed},
+      {"SUBMITTED", AccountStatus::Submitted},
+      {"ACCOUNT_UPDATED", AccountStatus::AccountUpdated},
+      {"APPROVAL_PENDING", AccountStatus::ApprovalPending},
+      {"ACTIVE", AccountStatus::Active},
+      {"REJECTED", AccountStatus::Rejected},
+  };
+};
+
 /**
  * @brief A type representing an Alpaca account.
  */
@@ -20,30 +52,40 @@ class Account {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   bool account_blocked;
   std::string account_number;
-  std::string buying_power;
-  std::string cash;
-  std::string created_at;
+  Decimal buying_power;
+  Decimal cash;
+  Timestamp created_at;
   std::string currency;
   int daytrade_count;
-  std::string daytrading_buying_power;
-  std::string equity;
+  Decimal daytrading_buying_power;
+  Decimal equity;
   std::string id;
-  std::string initial_margin;
-  std::string last_equity;
-  std::string last_maintenance_margin;
-  std::string long_market_value;
-  std::string maintenance_margin;
-  std::string multiplier;
+  Decimal initial_margin;
+  Decimal last_equity;
+  Decimal last_maintenance_margin;
+  Decimal long_market_value;
+  Decimal maintenance_margin;
+  Decimal multiplier;
   bool pattern_day_trader;
-  std::string portfolio_value;
-  std::string regt_buying_power;
-  std::string short_market_value;
+  Decimal portfolio_value;
+  Decimal regt_buying_power;
+  Decimal short_market_value;
   bool shorting_enabled;
-  std::string sma;
-  std::string status;
+  Decimal sma;
+  Enum<AccountStatus> status;
   bool trade_suspended_by_user;
   bool trading_blocked;
   bool transfers_blocked;
@@ -63,6 +105,16 @@ class AccountConfigurations {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   std::string dtbp_check;
   bool no_shorting;
@@ -84,17 +136,27 @@ class TradeActivity {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   std::string activity_type;
-  std::string cum_qty;
+  Decimal cum_qty;
   std::string id;
-  std::string leaves_qty;
+  Decimal leaves_qty;
   std::string order_id;
-  std::string price;
-  std::string qty;
+  Decimal price;
+  Decimal qty;
   std::string side;
-  std::string symbol;
-  std::string transaction_time;
+  SymbolId symbol;
+  Timestamp transaction_time;
   std::string type;
 };
 
@@ -112,13 +174,23 @@ class NonTradeActivity {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   std::string activity_type;
-  std::string date;
+  Timestamp date;
   std::string id;
-  std::string net_amount;
-  std::string per_share_amount;
-  std::string qty;
-  std::string symbol;
+  Decimal net_amount;
+  Decimal per_share_amount;
+  Decimal qty;
+  SymbolId symbol;
 };
 } // namespace alpaca
\ No newline at end of file
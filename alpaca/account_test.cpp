@@ -74,6 +74,7 @@ TEST_F(AccountTest, testAccountConfigurationFromJSON) {
   alpaca::Account account;
   EXPECT_OK(account.fromJSON(kAccountsJSON));
   EXPECT_EQ(account.account_number, "010203ABCD");
+  EXPECT_EQ(account.status, alpaca::AccountStatus::Active);
 }
 
 TEST_F(AccountTest, testAccountConfigurationsFromJSON) {
@@ -6,10 +6,14 @@
 #include "alpaca/client.h"
 #include "alpaca/clock.h"
 #include "alpaca/config.h"
+#include "alpaca/decimal.h"
+#include "alpaca/enum.h"
 #include "alpaca/order.h"
 #include "alpaca/portfolio.h"
 #include "alpaca/position.h"
 #include "alpaca/status.h"
 #include "alpaca/streaming.h"
+#include "alpaca/symbol.h"
+#include "alpaca/timestamp.h"
 #include "alpaca/trade.h"
 #include "alpaca/watchlist.h"
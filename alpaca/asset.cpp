@@ -1,37 +1,38 @@
 #include "alpaca/asset.h"
 
-#include "alpaca/json.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
 
 namespace alpaca {
 
+namespace {
+constexpr auto kAssetSchema = makeSchema<Asset>("an asset",
+    {
+        {"class", &parseEnum<&Asset::asset_class>},
+        {"easy_to_borrow", &Asset::easy_to_borrow},
+        {"exchange", &parseEnum<&Asset::exchange>},
+        {"id", &Asset::id},
+        {"marginable", &Asset::marginable},
+        {"shortable", &Asset::shortable},
+        {"status", &parseEnum<&Asset::status>},
+        {"symbol", &Asset::symbol},
+        {"tradable", &Asset::tradable},
+    });
+} // namespace
+
 std::string assetClassToString(const AssetClass asset_class) {
-  switch (asset_class) {
-  case USEquity:
-    return "us_equity";
-  }
+  return Enum<AssetClass>(asset_class).toString();
 }
 
 Status Asset::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing asset JSON");
-  }
-
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't an asset object");
-  }
+  return fromJSON(json.data(), json.size());
+}
 
-  PARSE_STRING(asset_class, "class")
-  PARSE_BOOL(easy_to_borrow, "easy_to_borrow")
-  PARSE_STRING(exchange, "exchange")
-  PARSE_STRING(id, "id")
-  PARSE_BOOL(marginable, "marginable")
-  PARSE_BOOL(shortable, "shortable")
-  PARSE_STRING(status, "status")
-  PARSE_STRING(symbol, "symbol")
-  PARSE_BOOL(tradable, "tradable")
+Status Asset::fromJSON(const char* json, const size_t length) {
+  return kAssetSchema.parse(json, length, *this);
+}
 
-  return Status();
+Status Asset::fromDocument(const rapidjson::Value& d) {
+  return kAssetSchema.read(d, *this);
 }
 } // namespace alpaca
\ No newline at end of file
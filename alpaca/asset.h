@@ -2,15 +2,26 @@
 
 #include <string>
 
+#include "alpaca/enum.h"
 #include "alpaca/status.h"
+#include "alpaca/symbol.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
 /**
  * @brief The class of an asset.
  */
-enum AssetClass {
+enum class AssetClass {
   USEquity,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<AssetClass> {
+  static constexpr EnumName<AssetClass> kNames[] = {
+      {"us_equity", AssetClass::USEquity},
+  };
 };
 
 /**
@@ -18,6 +29,50 @@ enum AssetClass {
  */
 std::string assetClassToString(const AssetClass asset_class);
 
+/**
+ * @brief Whether an asset is active.
+ */
+enum class AssetStatus {
+  Active,
+  Inactive,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<AssetStatus> {
+  static constexpr EnumName<AssetStatus> kNames[] = {
+      {"active", AssetStatus::Active},
+      {"inactive", AssetStatus::Inactive},
+  };
+};
+
+/**
+ * @brief The exchange an asset is listed on.
+ */
+enum class Exchange {
+  AMEX,
+  ARCA,
+  BATS,
+  NYSE,
+  NASDAQ,
+  NYSEARCA,
+  OTC,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<Exchange> {
+  static constexpr EnumName<Exchange> kNames[] = {
+      {"AMEX", Exchange::AMEX},
+      {"ARCA", Exchange::ARCA},
+      {"BATS", Exchange::BATS},
+      {"NYSE", Exchange::NYSE},
+      {"NASDAQ", Exchange::NASDAQ},
+      {"NYSEARCA", Exchange::NYSEARCA},
+      {"OTC", Exchange::OTC},
+  };
+};
+
 /**
  * @brief A type representing an Alpaca asset.
  */
@@ -32,15 +87,36 @@ class Asset {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing JSON which needn't be null terminated,
+   * such as an element of a streamed list, into the current object state.
+   *
+   * @param json The JSON characters
+   * @param length The number of characters
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromJSON(const char* json, const size_t length);
+
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
-  std::string asset_class;
+  Enum<AssetClass> asset_class;
   bool easy_to_borrow;
-  std::string exchange;
+  Enum<Exchange> exchange;
   std::string id;
   bool marginable;
   bool shortable;
-  std::string status;
-  std::string symbol;
+  Enum<AssetStatus> status;
+  SymbolId symbol;
   bool tradable;
 };
 } // namespace alpaca
\ No newline at end of file
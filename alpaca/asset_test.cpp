@@ -23,4 +23,7 @@ TEST_F(AssetTest, testAssetFromJSON) {
   alpaca::Asset asset;
   EXPECT_OK(asset.fromJSON(kAssetJSON));
   EXPECT_EQ(asset.symbol, "AAPL");
+  EXPECT_EQ(asset.asset_class, alpaca::AssetClass::USEquity);
+  EXPECT_EQ(asset.exchange, alpaca::Exchange::NASDAQ);
+  EXPECT_EQ(asset.status, alpaca::AssetStatus::Active);
 }
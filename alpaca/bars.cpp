@@ -1,53 +1,153 @@
 #include "alpaca/bars.h"
 
-#include "alpaca/json.h"
+#include <algorithm>
+#include <iterator>
+
+#include "alpaca/parse_arena.h"
+#include "alpaca/schema.h"
+#include "alpaca/timestamp.h"
 #include "glog/logging.h"
 #include "rapidjson/document.h"
 
 namespace alpaca {
 
-Status Bar::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing bar JSON");
+namespace {
+constexpr auto kBarSchema = makeSchema<Bar>("a bar",
+    {
+        {"t", &Bar::time},
+        {"o", &Bar::open_price},
+        {"h", &Bar::high_price},
+        {"l", &Bar::low_price},
+        {"c", &Bar::close_price},
+        {"v", &Bar::volume},
+    });
+
+/**
+ * @brief The number of seconds spanned by a bar of a timeframe, or zero if the
+ * timeframe is unknown.
+ */
+int64_t barSeconds(const std::string& timeframe) {
+  if (timeframe == "minute" || timeframe == "1Min") {
+    return 60;
+  } else if (timeframe == "5Min") {
+    return 5 * 60;
+  } else if (timeframe == "15Min") {
+    return 15 * 60;
+  } else if (timeframe == "day" || timeframe == "1D") {
+    return 24 * 60 * 60;
   }
+  return 0;
+}
 
-  return fromDocument(d);
+} // namespace
+
+Status Bar::fromJSON(const std::string& json) {
+  return fromJSON(json.data(), json.size());
 }
 
-Status Bar::fromDocument(
-    const rapidjson::GenericValue<rapidjson::UTF8<char>, rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>>& d) {
-  PARSE_UINT(time, "t")
-  PARSE_DOUBLE(open_price, "o")
-  PARSE_DOUBLE(high_price, "h")
-  PARSE_DOUBLE(low_price, "l")
-  PARSE_DOUBLE(close_price, "c")
-  PARSE_UINT(volume, "v")
+Status Bar::fromJSON(const char* json, const size_t length) {
+  return kBarSchema.parse(json, length, *this);
+}
 
-  return Status();
+Status Bar::fromDocument(const rapidjson::Value& d) {
+  return kBarSchema.read(d, *this);
 }
 
 Status Bars::fromJSON(const std::string& json) {
-  rapidjson::Document d;
+  ParseArena arena;
+  auto& d = arena.document();
   if (d.Parse(json.c_str()).HasParseError()) {
     return Status(1, "Received parse error when deserializing bars JSON");
   }
 
+  return fromDocument(d);
+}
+
+Status Bars::fromDocument(const rapidjson::Value& d) {
   if (!d.IsObject()) {
     return Status(1, "Deserialized valid JSON but it wasn't bars object");
   }
 
   for (auto symbol_bars = d.MemberBegin(); symbol_bars != d.MemberEnd(); symbol_bars++) {
-    bars[symbol_bars->name.GetString()] = std::vector<Bar>{};
+    if (!symbol_bars->value.IsArray()) {
+      return Status(1, "Deserialized valid JSON but it wasn't an array of bars");
+    }
+    auto& target = bars[SymbolId::intern(symbol_bars->name.GetString(), symbol_bars->name.GetStringLength())];
+    target.clear();
+    target.reserve(symbol_bars->value.Size());
     for (auto& symbol_bar : symbol_bars->value.GetArray()) {
       Bar bar;
-      if (auto status = bar.fromDocument(symbol_bar.GetObject()); !status.ok()) {
+      if (auto status = bar.fromDocument(symbol_bar); !status.ok()) {
         return status;
       }
-      bars[symbol_bars->name.GetString()].push_back(bar);
+      target.push_back(bar);
     }
   }
 
   return Status();
 }
-} // namespace alpaca
\ No newline at end of file
+
+void Bars::merge(Bars&& other) {
+  auto byTime = [](const Bar& a, const Bar& b) { return a.time < b.time; };
+  auto sameTime = [](const Bar& a, const Bar& b) { return a.time == b.time; };
+  for (auto& [symbol, other_bars] : other.bars) {
+    auto& symbol_bars = bars[symbol];
+    auto middle = symbol_bars.size();
+    symbol_bars.insert(
+        symbol_bars.end(), std::make_move_iterator(other_bars.begin()), std::make_move_iterator(other_bars.end()));
+    if (middle == 0 || middle == symbol_bars.size()) {
+      continue;
+    }
+
+    auto& last = symbol_bars[middle - 1];
+    auto& first = symbol_bars[middle];
+    if (last.time < first.time) {
+      continue;
+    } else if (last.time == first.time) {
+      // Consecutive windows which share a boundary both return its bar.
+      symbol_bars.erase(symbol_bars.begin() + middle);
+    } else {
+      std::inplace_merge(symbol_bars.begin(), symbol_bars.begin() + middle, symbol_bars.end(), byTime);
+      symbol_bars.erase(std::unique(symbol_bars.begin(), symbol_bars.end(), sameTime), symbol_bars.end());
+    }
+  }
+}
+
+std::pair<Status, std::vector<std::pair<std::string, std::string>>> splitBarsRange(const std::string& start,
+                                                                                     const std::string& end,
+                                                                                     const std::string& timeframe,
+                                                                                     const uint limit) {
+  std::vector<std::pair<std::string, std::string>> windows;
+  if (start == "" || end == "") {
+    windows.emplace_back(start, end);
+    return std::make_pair(Status(), windows);
+  }
+
+  auto bar_seconds = barSeconds(timeframe);
+  if (bar_seconds == 0) {
+    return std::make_pair(Status(1, "Unknown bars timeframe: " + timeframe), windows);
+  }
+  Timestamp start_time, end_time;
+  if (!Timestamp::parse(start.data(), start.size(), start_time).ok() ||
+      !Timestamp::parse(end.data(), end.size(), end_time).ok()) {
+    return std::make_pair(Status(1, "Could not parse bars range " + start + " to " + end), windows);
+  }
+  auto start_seconds = start_time.seconds();
+  auto end_seconds = end_time.seconds();
+  if (end_seconds < start_seconds) {
+    return std::make_pair(Status(1, "Bars range ends before it starts: " + start + " to " + end), windows);
+  }
+
+  // The first and last windows keep the caller's own timestamps.
+  auto span = bar_seconds * std::max<int64_t>(limit, 1);
+  for (auto t = start_seconds;; t += span) {
+    auto window_start = t == start_seconds ? start : Timestamp::fromSeconds(t).toString();
+    if (t + span > end_seconds) {
+      windows.emplace_back(window_start, end);
+      break;
+    }
+    windows.emplace_back(window_start, Timestamp::fromSeconds(t + span - 1).toString());
+  }
+  return std::make_pair(Status(), windows);
+}
+} // namespace alpaca
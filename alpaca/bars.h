@@ -1,14 +1,22 @@
 #pragma once
 
-#include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "alpaca/status.h"
+#include "alpaca/symbol.h"
 #include "rapidjson/document.h"
 
 namespace alpaca {
 
+/// The most symbols the bars endpoint accepts in a single request
+const size_t kMaxBarsSymbols = 200;
+
+/// The most bars per symbol the bars endpoint returns for a single request
+const uint kMaxBarsLimit = 1000;
+
 /**
  * @brief A type representing an Alpaca bar.
  */
@@ -24,14 +32,25 @@ class Bar {
   Status fromJSON(const std::string& json);
 
   /**
-   * @brief A method for deserializing JSON into the current object state.
+   * @brief A method for deserializing JSON which needn't be null terminated,
+   * such as an element of a streamed list, into the current object state.
    *
-   * @param json The JSON string
+   * @param json The JSON characters
+   * @param length The number of characters
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromJSON(const char* json, const size_t length);
+
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
    *
    * @return a Status indicating the success or faliure of the operation.
    */
-  Status fromDocument(
-      const rapidjson::GenericValue<rapidjson::UTF8<char>, rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>>& d);
+  Status fromDocument(const rapidjson::Value& d);
 
  public:
   uint time;
@@ -56,7 +75,42 @@ class Bars {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
+  /**
+   * @brief Merge the bars of another request into this object.
+   *
+   * The bars of each symbol are kept in timestamp order, and bars for a
+   * timestamp which is already present are dropped. Merging requests in
+   * chronological order only appends.
+   */
+  void merge(Bars&& other);
+
  public:
-  std::map<std::string, std::vector<Bar>> bars;
+  std::unordered_map<SymbolId, std::vector<Bar>> bars;
 };
+
+/**
+ * @brief Split a time range into consecutive windows which each span at most
+ * limit bars of a timeframe.
+ *
+ * start and end are RFC3339 timestamps or dates. If either is empty the range
+ * is returned as a single window.
+ *
+ * @return a std::pair where the first element is a Status indicating the
+ * success or faliure of the operation and the second element is a list of
+ * start and end pairs.
+ */
+std::pair<Status, std::vector<std::pair<std::string, std::string>>> splitBarsRange(const std::string& start,
+                                                                                     const std::string& end,
+                                                                                     const std::string& timeframe,
+                                                                                     const uint limit);
 } // namespace alpaca
@@ -1,5 +1,9 @@
 #include "alpaca/bars.h"
 
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include "alpaca/testing.h"
 #include "glog/logging.h"
 #include "gtest/gtest.h"
@@ -52,4 +56,70 @@ TEST_F(BarTest, testBarsFromJSON) {
   EXPECT_EQ(bar.low_price, 172.16);
   EXPECT_EQ(bar.close_price, 172.18);
   EXPECT_EQ(bar.volume, 3892);
-}
\ No newline at end of file
+}
+
+namespace {
+alpaca::Bars barsAt(const std::string& symbol, const std::vector<uint>& times) {
+  alpaca::Bars bars;
+  for (auto time : times) {
+    alpaca::Bar bar;
+    bar.time = time;
+    bars.bars[symbol].push_back(bar);
+  }
+  return bars;
+}
+
+std::vector<uint> timesOf(const std::vector<alpaca::Bar>& bars) {
+  std::vector<uint> times;
+  for (const auto& bar : bars) {
+    times.push_back(bar.time);
+  }
+  return times;
+}
+} // namespace
+
+TEST_F(BarTest, testBarsMerge) {
+  alpaca::Bars bars;
+  bars.merge(barsAt("AAPL", {1, 2, 3}));
+  bars.merge(barsAt("AAPL", {3, 4}));
+  bars.merge(barsAt("GOOG", {1}));
+  EXPECT_EQ(timesOf(bars.bars["AAPL"]), std::vector<uint>({1, 2, 3, 4}));
+  EXPECT_EQ(timesOf(bars.bars["GOOG"]), std::vector<uint>({1}));
+
+  // Out of order windows are merged in timestamp order too.
+  bars.merge(barsAt("AAPL", {0, 2, 5}));
+  EXPECT_EQ(timesOf(bars.bars["AAPL"]), std::vector<uint>({0, 1, 2, 3, 4, 5}));
+}
+
+TEST_F(BarTest, testSplitBarsRange) {
+  auto [status, windows] = alpaca::splitBarsRange("2020-01-01T00:00:00Z", "2020-01-01T05:00:00Z", "1Min", 120);
+  EXPECT_OK(status);
+  ASSERT_EQ(windows.size(), 3);
+  EXPECT_EQ(windows[0].first, "2020-01-01T00:00:00Z");
+  EXPECT_EQ(windows[0].second, "2020-01-01T01:59:59Z");
+  EXPECT_EQ(windows[1].first, "2020-01-01T02:00:00Z");
+  EXPECT_EQ(windows[1].second, "2020-01-01T03:59:59Z");
+  EXPECT_EQ(windows[2].first, "2020-01-01T04:00:00Z");
+  EXPECT_EQ(windows[2].second, "2020-01-01T05:00:00Z");
+}
+
+TEST_F(BarTest, testSplitBarsRangeWithOffset) {
+  auto [status, windows] = alpaca::splitBarsRange("2020-04-01T09:30:00-04:00", "2020-04-07", "1D", 1000);
+  EXPECT_OK(status);
+  ASSERT_EQ(windows.size(), 1);
+  EXPECT_EQ(windows[0].first, "2020-04-01T09:30:00-04:00");
+  EXPECT_EQ(windows[0].second, "2020-04-07");
+
+  std::tie(status, windows) = alpaca::splitBarsRange("2020-04-01T09:30:00-04:00", "2020-04-03", "day", 1);
+  EXPECT_OK(status);
+  ASSERT_EQ(windows.size(), 2);
+  EXPECT_EQ(windows[0].second, "2020-04-02T13:29:59Z");
+  EXPECT_EQ(windows[1].first, "2020-04-02T13:30:00Z");
+}
+
+TEST_F(BarTest, testSplitBarsRangeErrors) {
+  EXPECT_NOT_OK(alpaca::splitBarsRange("2020-01-01", "2020-01-02", "1Hour", 100).first);
+  EXPECT_NOT_OK(alpaca::splitBarsRange("yesterday", "2020-01-02", "1D", 100).first);
+  EXPECT_NOT_OK(alpaca::splitBarsRange("2020-01-02", "2020-01-01", "1D", 100).first);
+  EXPECT_EQ(alpaca::splitBarsRange("", "", "1D", 100).second.size(), 1);
+}
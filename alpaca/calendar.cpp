@@ -1,23 +1,24 @@
 #include "alpaca/calendar.h"
 
-#include "alpaca/json.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
 
 namespace alpaca {
-Status Date::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing calendar JSON");
-  }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a calendar object");
-  }
+namespace {
+constexpr auto kDateSchema = makeSchema<Date>("a calendar",
+    {
+        {"close", &Date::close},
+        {"date", &Date::date},
+        {"open", &Date::open},
+    });
+} // namespace
 
-  PARSE_STRING(close, "close")
-  PARSE_STRING(date, "date")
-  PARSE_STRING(open, "open")
+Status Date::fromJSON(const std::string& json) {
+  return kDateSchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status Date::fromDocument(const rapidjson::Value& d) {
+  return kDateSchema.read(d, *this);
 }
 } // namespace alpaca
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <string>
 
 #include "alpaca/status.h"
+#include "alpaca/timestamp.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
@@ -20,9 +22,19 @@ class Date {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   std::string close;
-  std::string date;
+  Timestamp date;
   std::string open;
 };
 } // namespace alpaca
\ No newline at end of file
@@ -18,5 +18,5 @@ TEST_F(CalendarTest, testDateFromJSON) {
   EXPECT_OK(date.fromJSON(kDateJSON));
   EXPECT_EQ(date.open, "09:30");
   EXPECT_EQ(date.close, "16:00");
-  EXPECT_EQ(date.date, "2018-01-03");
+  EXPECT_EQ(date.date, alpaca::Timestamp("2018-01-03"));
 }
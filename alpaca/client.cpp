@@ -1,38 +1,250 @@
 #include "alpaca/client.h"
 
+#include <algorithm>
+#include <thread>
 #include <utility>
 
+#include "alpaca/executor.h"
+#include "alpaca/http.h"
+#include "alpaca/incremental_parser.h"
+#include "alpaca/parse_arena.h"
+#include "alpaca/response_cache.h"
+#include "alpaca/retry.h"
+#include "alpaca/snapshot.h"
+#include "alpaca/transport.h"
 #include "glog/logging.h"
-#include "httplib.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
 namespace alpaca {
 
-const char* kJSONContentType = "application/json";
+namespace {
+std::string assetsCacheKey(const ActionStatus asset_status, const AssetClass asset_class) {
+  return "assets?" + actionStatusToString(asset_status) + "&" + assetClassToString(asset_class);
+}
 
-httplib::Headers headers(const Environment& environment) {
-  return {
-      {"APCA-API-KEY-ID", environment.getAPIKeyID()},
-      {"APCA-API-SECRET-KEY", environment.getAPISecretKey()},
-  };
+std::string calendarCacheKey(const std::string& start, const std::string& end) {
+  return "calendar?" + start + "&" + end;
+}
+
+/**
+ * @brief Send a GET request for a JSON list whose elements are parsed as each
+ * chunk of the body arrives, on the thread which receives it.
+ *
+ * reset() is called before the body of each attempt is parsed, so that the
+ * elements of an attempt which failed part way through can be discarded. The
+ * rest of the body is not read once parsing has failed.
+ *
+ * @param parse_status Set to the result of parsing the body of an HTTP 200.
+ */
+std::shared_ptr<httplib::Response> getIncrementally(Transport& transport,
+                                                    const APIHost host,
+                                                    const RequestPriority priority,
+                                                    const EndpointClass endpoint,
+                                                    const std::string& url,
+                                                    const std::function<void()>& reset,
+                                                    const IncrementalParser::ElementCallback& on_element,
+                                                    Status& parse_status,
+                                                    const IncrementalParser::KeyCallback& on_key = nullptr) {
+  std::unique_ptr<IncrementalParser> parser;
+  auto resp = transport.GetStreamed(host, priority, endpoint, url, [&]() {
+    parser.reset();
+    reset();
+    parser = std::make_unique<IncrementalParser>(on_element, on_key);
+    return [parser = parser.get()](const char* data, size_t length) { return parser->feed(data, length); };
+  });
+  if (parser && resp && resp->status == 200) {
+    parse_status = parser->finish();
+  }
+  return resp;
 }
 
-Client::Client(Environment& environment) {
+/**
+ * @brief Parse the body of a response into the document of an arena.
+ *
+ * Unless the response is shared with a coalesced request, the body is parsed
+ * in situ: strings in the document point into the body, which is overwritten,
+ * instead of being copied into the document's pool.
+ *
+ * @param shared Whether another request may also read the response.
+ */
+PooledDocument& parseBody(ParseArena& arena, const std::shared_ptr<httplib::Response>& resp, const bool shared) {
+  auto& d = arena.document();
+  if (shared) {
+    d.Parse(resp->body.c_str(), resp->body.size());
+  } else {
+    d.ParseInsitu(&resp->body[0]);
+  }
+  return d;
+}
+} // namespace
+
+Client::Client(Environment& environment, const ClientOptions& options) {
   if (!environment.hasBeenParsed()) {
     if (auto s = environment.parse(); !s.ok()) {
       LOG(ERROR) << "Error parsing the environment: " << s.getMessage();
     }
   }
-  environment_ = environment;
+  options_ = options;
+  executor_ = std::make_shared<Executor>(options_.io_threads);
+  transport_ = std::make_shared<Transport>(environment, options_, executor_);
+  cache_ = std::make_shared<ResponseCache>();
+
+  if (!options_.snapshot_policy.path.empty()) {
+    loadSnapshot();
+    executor_->submit([client = *this]() {
+      if (auto s = client.refreshSnapshot(); !s.ok()) {
+        LOG(WARNING) << "Error refreshing the snapshot: " << s.getMessage();
+      }
+    });
+  }
+
+  if (options_.warm_connections > 0) {
+    // Connections are warmed in the background so that constructing a client
+    // never waits on the network.
+    executor_->submit([client = *this]() {
+      if (auto s = client.warmup(); !s.ok()) {
+        LOG(WARNING) << "Error warming up connections: " << s.getMessage();
+      }
+    });
+    transport_->startKeepWarm(options_.warm_connections, options_.keep_warm_interval);
+  }
+}
+
+RateLimiter& Client::getRateLimiter() const {
+  return transport_->getRateLimiter();
+}
+
+Status Client::warmup(size_t connections) const {
+  if (connections == 0) {
+    connections = std::max<size_t>(options_.warm_connections, 1);
+  }
+  // Connections beyond the size of the pool would be closed straight away.
+  connections = std::min(connections, options_.connection_pool_size);
+
+  auto warmed = transport_->warmup(connections);
+  if (warmed < connections) {
+    std::ostringstream ss;
+    ss << "Only " << warmed << " of " << connections << " connections could be warmed up";
+    return Status(1, ss.str());
+  }
+  return Status();
+}
+
+void Client::invalidateCache() const {
+  cache_->invalidate();
+}
+
+Status Client::refreshSnapshot() const {
+  const auto& policy = options_.snapshot_policy;
+  if (policy.path.empty()) {
+    return Status(1, "No snapshot path is configured");
+  }
+
+  Snapshot snapshot;
+  snapshot.created = std::chrono::system_clock::now();
+  auto assets = fetchAssets(ActionStatus::Active, AssetClass::USEquity);
+  if (!assets.first.ok()) {
+    return assets.first;
+  }
+  snapshot.assets = std::move(assets.second);
+  if (!policy.calendar_start.empty() && !policy.calendar_end.empty()) {
+    auto calendar = fetchCalendar(policy.calendar_start, policy.calendar_end);
+    if (!calendar.first.ok()) {
+      return calendar.first;
+    }
+    snapshot.calendar_start = policy.calendar_start;
+    snapshot.calendar_end = policy.calendar_end;
+    snapshot.calendar = std::move(calendar.second);
+  }
+
+  if (auto s = writeSnapshot(policy.path, snapshot); !s.ok()) {
+    return s;
+  }
+
+  auto ttl = std::chrono::duration_cast<std::chrono::milliseconds>(policy.max_age);
+  cacheAssets(assetsCacheKey(ActionStatus::Active, AssetClass::USEquity),
+              std::make_shared<const std::vector<Asset>>(std::move(snapshot.assets)),
+              ttl);
+  if (!snapshot.calendar_start.empty()) {
+    cache_->put(calendarCacheKey(snapshot.calendar_start, snapshot.calendar_end),
+                std::make_shared<const std::vector<Date>>(std::move(snapshot.calendar)),
+                ttl);
+  }
+  return Status();
+}
+
+void Client::cacheAssets(const std::string& key,
+                         const std::shared_ptr<const std::vector<Asset>>& assets,
+                         const std::chrono::milliseconds ttl) const {
+  cache_->put(key, assets, ttl);
+  // Every listed asset is also served to getAsset() until the list expires.
+  for (const auto& asset : *assets) {
+    cache_->put("asset/" + asset.symbol.toString(), std::make_shared<const Asset>(asset), ttl);
+  }
+}
+
+void Client::loadSnapshot() const {
+  const auto& policy = options_.snapshot_policy;
+  auto [status, snapshot] = readSnapshot(policy.path);
+  if (!status.ok()) {
+    LOG(INFO) << "Not loading a snapshot: " << status.getMessage();
+    return;
+  }
+
+  auto age = std::chrono::system_clock::now() - snapshot.created;
+  if (age >= policy.max_age) {
+    LOG(INFO) << "Not loading the snapshot at " << policy.path << " because it is stale";
+    return;
+  }
+
+  // Entries expire when the snapshot becomes stale rather than max_age after
+  // it was loaded.
+  auto ttl = std::chrono::duration_cast<std::chrono::milliseconds>(policy.max_age - age);
+  cacheAssets(assetsCacheKey(ActionStatus::Active, AssetClass::USEquity),
+              std::make_shared<const std::vector<Asset>>(std::move(snapshot.assets)),
+              ttl);
+  if (!snapshot.calendar_start.empty()) {
+    cache_->put(calendarCacheKey(snapshot.calendar_start, snapshot.calendar_end),
+                std::make_shared<const std::vector<Date>>(std::move(snapshot.calendar)),
+                ttl);
+  }
+}
+
+template <typename T>
+std::future<T> Client::async(std::function<T(const Client&)> call, std::function<void(const T&)> callback) const {
+  // The task owns a copy of the client so that it remains valid even if this
+  // client is destroyed before the call completes.
+  return executor_->submit([client = *this, call = std::move(call), callback = std::move(callback)]() {
+    auto result = call(client);
+    if (callback) {
+      callback(result);
+    }
+    return result;
+  });
+}
+
+template <typename T>
+std::pair<Status, std::shared_ptr<const T>> Client::cached(const std::string& key,
+                                                           const std::chrono::milliseconds ttl,
+                                                           const std::function<std::pair<Status, T>()>& fetch) const {
+  if (auto value = cache_->get<T>(key)) {
+    return std::make_pair(Status(), value);
+  }
+
+  auto result = fetch();
+  auto value = std::make_shared<const T>(std::move(result.second));
+  if (result.first.ok() && ttl.count() > 0) {
+    cache_->put(key, value, ttl);
+  }
+  return std::make_pair(result.first, value);
 }
 
 std::pair<Status, Account> Client::getAccount() const {
   Account account;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Get("/v2/account", headers(environment_));
+  auto resp = transport_->Get(TradingHost, AccountPriority, TradingEndpoint, "/v2/account");
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/account returned an empty response"), account);
   }
@@ -50,8 +262,7 @@ std::pair<Status, Account> Client::getAccount() const {
 std::pair<Status, AccountConfigurations> Client::getAccountConfigurations() const {
   AccountConfigurations account_configurations;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Get("/v2/account/configurations", headers(environment_));
+  auto resp = transport_->Get(TradingHost, AccountPriority, TradingEndpoint, "/v2/account/configurations");
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/account/configurations returned an empty response"),
                           account_configurations);
@@ -93,8 +304,7 @@ std::pair<Status, AccountConfigurations> Client::updateAccountConfigurations(con
   writer.EndObject();
   auto body = s.GetString();
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Patch("/v2/account/configurations", headers(environment_), body, kJSONContentType);
+  auto resp = transport_->Patch(TradingHost, AccountPriority, TradingEndpoint, "/v2/account/configurations", body);
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/account/configurations returned an empty response"),
                           account_configurations);
@@ -112,9 +322,30 @@ std::pair<Status, AccountConfigurations> Client::updateAccountConfigurations(con
 
 std::pair<Status, std::vector<std::variant<TradeActivity, NonTradeActivity>>> Client::getAccountActivity(
     const std::vector<std::string>& activity_types) const {
+  return fetchAccountActivity(activity_types, OrderDirection::Descending, 0, "");
+}
+
+Paginated<std::variant<TradeActivity, NonTradeActivity>> Client::iterateAccountActivity(
+    const std::vector<std::string>& activity_types, const OrderDirection direction, const int page_size) const {
+  auto fetch = [client = *this, activity_types, direction, page_size](
+                   const std::variant<TradeActivity, NonTradeActivity>* last) {
+    std::string page_token;
+    if (last != nullptr) {
+      page_token = std::visit([](const auto& activity) { return activity.id; }, *last);
+    }
+    return client.fetchAccountActivity(activity_types, direction, page_size, page_token);
+  };
+  return Paginated<std::variant<TradeActivity, NonTradeActivity>>(fetch, page_size);
+}
+
+std::pair<Status, std::vector<std::variant<TradeActivity, NonTradeActivity>>> Client::fetchAccountActivity(
+    const std::vector<std::string>& activity_types,
+    const OrderDirection direction,
+    const int page_size,
+    const std::string& page_token) const {
   std::vector<std::variant<TradeActivity, NonTradeActivity>> activities;
 
-  std::string url = "/v2/account/activities";
+  std::string url = "/v2/account/activities?direction=" + orderDirectionToString(direction);
   if (activity_types.size() > 0) {
     std::string query_string = "";
     for (auto i = 0; i < activity_types.size(); ++i) {
@@ -122,12 +353,53 @@ std::pair<Status, std::vector<std::variant<TradeActivity, NonTradeActivity>>> Cl
       query_string += ",";
     }
     query_string.pop_back();
-    url += "?activity_types=" + query_string;
+    url += "&activity_types=" + query_string;
+  }
+  if (page_size > 0) {
+    url += "&page_size=" + std::to_string(page_size);
+  }
+  if (page_token != "") {
+    url += "&page_token=" + httplib::detail::encode_url(page_token);
   }
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  Status parse_status;
+  auto resp = getIncrementally(
+      *transport_,
+      TradingHost,
+      AccountPriority,
+      AccountActivityEndpoint,
+      url,
+      [&]() { activities.clear(); },
+      [&](const std::string&, const char* json, size_t length) {
+        ParseArena arena;
+        auto& a = arena.document();
+        if (a.Parse(json, length).HasParseError() || !a.IsObject()) {
+          return Status(1, "Received parse error when deserializing activities JSON");
+        }
+        std::string activity_type;
+        if (a.HasMember("activity_type") && a["activity_type"].IsString()) {
+          activity_type = a["activity_type"].GetString();
+        } else {
+          return Status(1, "Activity didn't have activity_type attribute");
+        }
+
+        if (activity_type == "FILL") {
+          TradeActivity activity;
+          if (auto status = activity.fromDocument(a); !status.ok()) {
+            return status;
+          }
+          activities.push_back(activity);
+        } else {
+          NonTradeActivity activity;
+          if (auto status = activity.fromDocument(a); !status.ok()) {
+            return status;
+          }
+          activities.push_back(activity);
+        }
+        return Status();
+      },
+      parse_status);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -140,41 +412,8 @@ std::pair<Status, std::vector<std::variant<TradeActivity, NonTradeActivity>>> Cl
     return std::make_pair(Status(1, ss.str()), activities);
   }
 
-  DLOG(INFO) << "Response from " << url << ": " << resp->body;
-
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
-    return std::make_pair(Status(1, "Received parse error when deserializing activities JSON"), activities);
-  }
-  for (auto& a : d.GetArray()) {
-    std::string activity_type;
-    if (a.HasMember("activity_type") && a["activity_type"].IsString()) {
-      activity_type = a["activity_type"].GetString();
-    } else {
-      return std::make_pair(Status(1, "Activity didn't have activity_type attribute"), activities);
-    }
-
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    a.Accept(writer);
-
-    if (activity_type == "FILL") {
-      TradeActivity activity;
-      if (auto status = activity.fromJSON(s.GetString()); !status.ok()) {
-        return std::make_pair(status, activities);
-      }
-      activities.push_back(activity);
-    } else {
-      NonTradeActivity activity;
-      if (auto status = activity.fromJSON(s.GetString()); !status.ok()) {
-        return std::make_pair(status, activities);
-      }
-      activities.push_back(activity);
-    }
-  }
-
-  return std::make_pair(Status(), activities);
+  DLOG(INFO) << "Parsed " << activities.size() << " activities from " << url;
+  return std::make_pair(parse_status, activities);
 }
 
 std::pair<Status, Order> Client::getOrder(const std::string& id, const bool nested) const {
@@ -185,9 +424,8 @@ std::pair<Status, Order> Client::getOrder(const std::string& id, const bool nest
     url += "?nested=true";
   }
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(TradingHost, AccountPriority, TradingEndpoint, url, true);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -209,9 +447,8 @@ std::pair<Status, Order> Client::getOrderByClientOrderID(const std::string& clie
 
   auto url = "/v2/orders:by_client_order_id?client_order_id=" + client_order_id;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(TradingHost, AccountPriority, TradingEndpoint, url);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -251,10 +488,25 @@ std::pair<Status, std::vector<Order>> Client::getOrders(const ActionStatus statu
     params.insert({"nested", "true"});
   }
   auto query_string = httplib::detail::params_to_query_str(params);
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   auto url = "/v2/orders?" + query_string;
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  Status parse_status;
+  auto resp = getIncrementally(
+      *transport_,
+      TradingHost,
+      AccountPriority,
+      TradingEndpoint,
+      url,
+      [&]() { orders.clear(); },
+      [&](const std::string&, const char* json, size_t length) {
+        Order order;
+        if (auto status = order.fromJSON(json, length); !status.ok()) {
+          return status;
+        }
+        orders.push_back(std::move(order));
+        return Status();
+      },
+      parse_status);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -267,25 +519,33 @@ std::pair<Status, std::vector<Order>> Client::getOrders(const ActionStatus statu
     return std::make_pair(Status(1, ss.str()), orders);
   }
 
-  DLOG(INFO) << "Response from " << url << ": " << resp->body;
+  DLOG(INFO) << "Parsed " << orders.size() << " orders from " << url;
+  return std::make_pair(parse_status, orders);
+}
 
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
-    return std::make_pair(Status(1, "Received parse error when deserializing orders JSON"), orders);
-  }
-  for (auto& o : d.GetArray()) {
-    Order order;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    o.Accept(writer);
-    if (auto status = order.fromJSON(s.GetString()); !status.ok()) {
-      return std::make_pair(status, orders);
+Paginated<Order> Client::iterateOrders(const ActionStatus status,
+                                       const std::string& after,
+                                       const std::string& until,
+                                       const OrderDirection direction,
+                                       const bool nested,
+                                       const int page_size) const {
+  auto fetch = [client = *this, status, after, until, direction, nested, page_size](const Timestamp* bound) {
+    // Both bounds are exclusive, so a bound is moved a nanosecond past the
+    // boundary to include the orders submitted at the same time as the last
+    // order seen.
+    if (bound == nullptr) {
+      return client.getOrders(status, page_size, after, until, direction, nested);
+    } else if (direction == OrderDirection::Ascending) {
+      auto bound_after = *bound - std::chrono::nanoseconds(1);
+      return client.getOrders(status, page_size, bound_after.toString(), until, direction, nested);
+    } else {
+      auto bound_until = *bound + std::chrono::nanoseconds(1);
+      return client.getOrders(status, page_size, after, bound_until.toString(), direction, nested);
     }
-    orders.push_back(order);
-  }
-
-  return std::make_pair(Status(), orders);
+  };
+  auto submitted_at = [](const Order& order) { return order.submitted_at; };
+  auto id = [](const Order& order) { return order.id; };
+  return Paginated<Order>(pageByTime<Order, Timestamp, std::string>(fetch, submitted_at, id, page_size), page_size);
 }
 
 std::pair<Status, Order> Client::submitOrder(const std::string& symbol,
@@ -293,91 +553,69 @@ std::pair<Status, Order> Client::submitOrder(const std::string& symbol,
                                              const OrderSide side,
                                              const OrderType type,
                                              const OrderTimeInForce tif,
-                                             const std::string& limit_price,
-                                             const std::string& stop_price,
+                                             const Decimal& limit_price,
+                                             const Decimal& stop_price,
                                              const bool extended_hours,
                                              const std::string& client_order_id,
                                              const OrderClass order_class,
                                              TakeProfitParams* take_profit_params,
                                              StopLossParams* stop_loss_params) const {
-  Order order;
-
-  rapidjson::StringBuffer s;
-  s.Clear();
-  rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-  writer.StartObject();
-
-  writer.Key("symbol");
-  writer.String(symbol.c_str());
-
-  writer.Key("qty");
-  writer.Int(quantity);
-
-  writer.Key("side");
-  writer.String(orderSideToString(side).c_str());
-
-  writer.Key("type");
-  writer.String(orderTypeToString(type).c_str());
-
-  writer.Key("time_in_force");
-  writer.String(orderTimeInForceToString(tif).c_str());
-
-  if (limit_price != "") {
-    writer.Key("limit_price");
-    writer.String(limit_price.c_str());
+  OrderRequest request;
+  request.symbol = symbol;
+  request.quantity = quantity;
+  request.side = side;
+  request.type = type;
+  request.time_in_force = tif;
+  request.limit_price = limit_price;
+  request.stop_price = stop_price;
+  request.extended_hours = extended_hours;
+  request.client_order_id = client_order_id;
+  request.order_class = order_class;
+  if (take_profit_params != nullptr) {
+    request.take_profit = *take_profit_params;
   }
-
-  if (stop_price != "") {
-    writer.Key("stop_price");
-    writer.String(stop_price.c_str());
+  if (stop_loss_params != nullptr) {
+    request.stop_loss = *stop_loss_params;
   }
+  return submitOrder(request);
+}
 
-  if (extended_hours) {
-    writer.Key("extended_hours");
-    writer.Bool(extended_hours);
-  }
+std::pair<Status, Order> Client::submitOrder(const OrderRequest& request) const {
+  Order order;
 
-  if (client_order_id != "") {
-    writer.Key("client_order_id");
-    writer.String(client_order_id.c_str());
-  }
+  auto body = request.toJSON();
 
-  if (order_class != OrderClass::Simple) {
-    writer.Key("order_class");
-    writer.String(orderClassToString(order_class).c_str());
-  }
+  DLOG(INFO) << "Sending request body to /v2/orders: " << body;
 
-  if (take_profit_params != nullptr) {
-    writer.Key("take_profit");
-    writer.StartObject();
-    if (take_profit_params->limitPrice != "") {
-      writer.Key("limit_price");
-      writer.String(take_profit_params->limitPrice.c_str());
+  // Submitting an order is only safe to retry when it carries a
+  // client_order_id: the API rejects duplicates, and an order which was
+  // accepted even though its response was lost can be found by that ID.
+  std::shared_ptr<httplib::Response> resp;
+  const auto& retry_policy = options_.retry_policy;
+  for (size_t attempt = 1;; ++attempt) {
+    resp = transport_->Post(TradingHost, OrderPriority, TradingEndpoint, "/v2/orders", body);
+    if (request.client_order_id.empty() || attempt >= retry_policy.max_attempts ||
+        (resp && !isRetryableStatus(resp->status))) {
+      break;
     }
-    writer.EndObject();
-  }
 
-  if (stop_loss_params != nullptr) {
-    writer.Key("stop_loss");
-    writer.StartObject();
-    if (stop_loss_params->limitPrice != "") {
-      writer.Key("limit_price");
-      writer.String(stop_loss_params->limitPrice.c_str());
+    auto delay = retryDelay(retry_policy, attempt, resp ? resp->get_header_value("Retry-After") : "");
+    if (delay > retry_policy.max_retry_after) {
+      break;
     }
-    if (stop_loss_params->stopPrice != "") {
-      writer.Key("stop_price");
-      writer.String(stop_loss_params->stopPrice.c_str());
+    LOG(WARNING) << "Retrying order " << request.client_order_id << " in " << delay.count() << "ms";
+    std::this_thread::sleep_for(delay);
+
+    // An HTTP 429 means that the order was never accepted.
+    if (!resp || resp->status != 429) {
+      auto existing = getOrderByClientOrderID(request.client_order_id);
+      if (existing.first.ok()) {
+        DLOG(INFO) << "Order " << request.client_order_id << " was accepted by a previous attempt";
+        return existing;
+      }
     }
-    writer.EndObject();
   }
 
-  writer.EndObject();
-  auto body = s.GetString();
-
-  DLOG(INFO) << "Sending request body to /v2/orders: " << body;
-
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Post("/v2/orders", headers(environment_), body, kJSONContentType);
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/orders returned an empty response"), order);
   }
@@ -393,11 +631,26 @@ std::pair<Status, Order> Client::submitOrder(const std::string& symbol,
   return std::make_pair(order.fromJSON(resp->body), order);
 }
 
+std::vector<std::pair<Status, Order>> Client::submitOrders(const std::vector<OrderRequest>& requests,
+                                                           size_t max_concurrency) const {
+  if (max_concurrency == 0) {
+    max_concurrency = options_.order_concurrency;
+  }
+
+  // Orders beyond the size of the pool would each open a connection which is
+  // closed again as soon as it is returned.
+  max_concurrency = std::min(max_concurrency, options_.connection_pool_size);
+
+  std::vector<std::pair<Status, Order>> results(requests.size());
+  parallelFor(*executor_, requests.size(), max_concurrency, [&](size_t i) { results[i] = submitOrder(requests[i]); });
+  return results;
+}
+
 std::pair<Status, Order> Client::replaceOrder(const std::string& id,
                                               const int quantity,
                                               const OrderTimeInForce tif,
-                                              const std::string& limit_price,
-                                              const std::string& stop_price,
+                                              const Decimal& limit_price,
+                                              const Decimal& stop_price,
                                               const std::string& client_order_id) const {
   Order order;
 
@@ -412,14 +665,14 @@ std::pair<Status, Order> Client::replaceOrder(const std::string& id,
   writer.Key("time_in_force");
   writer.String(orderTimeInForceToString(tif).c_str());
 
-  if (limit_price != "") {
+  if (!limit_price.empty()) {
     writer.Key("limit_price");
-    writer.String(limit_price.c_str());
+    writer.String(limit_price.toString().c_str());
   }
 
-  if (stop_price != "") {
+  if (!stop_price.empty()) {
     writer.Key("stop_price");
-    writer.String(stop_price.c_str());
+    writer.String(stop_price.toString().c_str());
   }
 
   if (client_order_id != "") {
@@ -433,8 +686,7 @@ std::pair<Status, Order> Client::replaceOrder(const std::string& id,
   auto url = "/v2/orders/" + id;
   DLOG(INFO) << "Sending request body to " << url << ": " << body;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Patch(url.c_str(), headers(environment_), body, kJSONContentType);
+  auto resp = transport_->Patch(TradingHost, OrderPriority, TradingEndpoint, url, body);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -455,9 +707,8 @@ std::pair<Status, Order> Client::replaceOrder(const std::string& id,
 std::pair<Status, std::vector<Order>> Client::cancelOrders() const {
   std::vector<Order> orders;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: /v2/orders";
-  auto resp = client.Delete("/v2/orders", headers(environment_));
+  auto resp = transport_->Delete(TradingHost, CancelPriority, TradingEndpoint, "/v2/orders");
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/orders returned an empty response"), orders);
   }
@@ -470,17 +721,14 @@ std::pair<Status, std::vector<Order>> Client::cancelOrders() const {
 
   DLOG(INFO) << "Response from /v2/orders: " << resp->body;
 
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
+  ParseArena arena;
+  auto& d = parseBody(arena, resp, false);
+  if (d.HasParseError()) {
     return std::make_pair(Status(1, "Received parse error when deserializing orders JSON"), orders);
   }
   for (auto& o : d.GetArray()) {
     Order order;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    o.Accept(writer);
-    if (auto status = order.fromJSON(s.GetString()); !status.ok()) {
+    if (auto status = order.fromDocument(o); !status.ok()) {
       return std::make_pair(status, orders);
     }
     orders.push_back(order);
@@ -492,10 +740,9 @@ std::pair<Status, std::vector<Order>> Client::cancelOrders() const {
 std::pair<Status, Order> Client::cancelOrder(const std::string& id) const {
   Order order;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   auto url = "/v2/orders/" + id;
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Delete(url.c_str(), headers(environment_));
+  auto resp = transport_->Delete(TradingHost, CancelPriority, TradingEndpoint, url, true);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -520,9 +767,9 @@ std::pair<Status, Order> Client::cancelOrder(const std::string& id) const {
 std::pair<Status, std::vector<Position>> Client::getPositions() const {
   std::vector<Position> positions;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: /v2/positions";
-  auto resp = client.Get("/v2/positions", headers(environment_));
+  bool shared;
+  auto resp = transport_->Get(TradingHost, AccountPriority, TradingEndpoint, "/v2/positions", false, &shared);
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/positions returned an empty response"), positions);
   }
@@ -535,17 +782,14 @@ std::pair<Status, std::vector<Position>> Client::getPositions() const {
 
   DLOG(INFO) << "Response from /v2/positions: " << resp->body;
 
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
+  ParseArena arena;
+  auto& d = parseBody(arena, resp, shared);
+  if (d.HasParseError()) {
     return std::make_pair(Status(1, "Received parse error when deserializing positions JSON"), positions);
   }
   for (auto& o : d.GetArray()) {
     Position position;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    o.Accept(writer);
-    if (auto status = position.fromJSON(s.GetString()); !status.ok()) {
+    if (auto status = position.fromDocument(o); !status.ok()) {
       return std::make_pair(status, positions);
     }
     positions.push_back(position);
@@ -559,9 +803,8 @@ std::pair<Status, Position> Client::getPosition(const std::string& symbol) const
 
   auto url = "/v2/positions/" + symbol;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(TradingHost, AccountPriority, TradingEndpoint, url, true);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -581,9 +824,8 @@ std::pair<Status, Position> Client::getPosition(const std::string& symbol) const
 std::pair<Status, std::vector<Position>> Client::closePositions() const {
   std::vector<Position> positions;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: /v2/positions";
-  auto resp = client.Delete("/v2/orders", headers(environment_));
+  auto resp = transport_->Delete(TradingHost, OrderPriority, TradingEndpoint, "/v2/orders");
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/positions returned an empty response"), positions);
   }
@@ -596,17 +838,14 @@ std::pair<Status, std::vector<Position>> Client::closePositions() const {
 
   DLOG(INFO) << "Response from /v2/positions: " << resp->body;
 
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
+  ParseArena arena;
+  auto& d = parseBody(arena, resp, false);
+  if (d.HasParseError()) {
     return std::make_pair(Status(1, "Received parse error when deserializing positions JSON"), positions);
   }
   for (auto& o : d.GetArray()) {
     Position position;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    o.Accept(writer);
-    if (auto status = position.fromJSON(s.GetString()); !status.ok()) {
+    if (auto status = position.fromDocument(o); !status.ok()) {
       return std::make_pair(status, positions);
     }
     positions.push_back(position);
@@ -618,10 +857,9 @@ std::pair<Status, std::vector<Position>> Client::closePositions() const {
 std::pair<Status, Position> Client::closePosition(const std::string& symbol) const {
   Position position;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   auto url = "/v2/positions/" + symbol;
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Delete(url.c_str(), headers(environment_));
+  auto resp = transport_->Delete(TradingHost, OrderPriority, TradingEndpoint, url);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -645,6 +883,27 @@ std::pair<Status, Position> Client::closePosition(const std::string& symbol) con
 
 std::pair<Status, std::vector<Asset>> Client::getAssets(const ActionStatus asset_status,
                                                         const AssetClass asset_class) const {
+  auto result = getSharedAssets(asset_status, asset_class);
+  return std::make_pair(result.first, *result.second);
+}
+
+std::pair<Status, std::shared_ptr<const std::vector<Asset>>> Client::getSharedAssets(
+    const ActionStatus asset_status, const AssetClass asset_class) const {
+  auto ttl = options_.cache_policy.assets_ttl;
+  auto key = assetsCacheKey(asset_status, asset_class);
+  auto fetched = false;
+  auto result = cached<std::vector<Asset>>(key, ttl, [&]() {
+    fetched = true;
+    return fetchAssets(asset_status, asset_class);
+  });
+  if (fetched && result.first.ok() && ttl.count() > 0) {
+    cacheAssets(key, result.second, ttl);
+  }
+  return result;
+}
+
+std::pair<Status, std::vector<Asset>> Client::fetchAssets(const ActionStatus asset_status,
+                                                          const AssetClass asset_class) const {
   std::vector<Asset> assets;
 
   httplib::Params params{
@@ -654,9 +913,24 @@ std::pair<Status, std::vector<Asset>> Client::getAssets(const ActionStatus asset
   auto query_string = httplib::detail::params_to_query_str(params);
   auto url = "/v2/assets?" + query_string;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  Status parse_status;
+  auto resp = getIncrementally(
+      *transport_,
+      TradingHost,
+      DataPriority,
+      ReferenceDataEndpoint,
+      url,
+      [&]() { assets.clear(); },
+      [&](const std::string&, const char* json, size_t length) {
+        Asset asset;
+        if (auto status = asset.fromJSON(json, length); !status.ok()) {
+          return status;
+        }
+        assets.push_back(std::move(asset));
+        return Status();
+      },
+      parse_status);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -669,35 +943,26 @@ std::pair<Status, std::vector<Asset>> Client::getAssets(const ActionStatus asset
     return std::make_pair(Status(1, ss.str()), assets);
   }
 
-  DLOG(INFO) << "Response from " << url << ": " << resp->body;
+  DLOG(INFO) << "Parsed " << assets.size() << " assets from " << url;
+  return std::make_pair(parse_status, assets);
+}
 
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
-    return std::make_pair(Status(1, "Received parse error when deserializing assets JSON"), assets);
-  }
-  for (auto& o : d.GetArray()) {
-    Asset asset;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    o.Accept(writer);
-    if (auto status = asset.fromJSON(s.GetString()); !status.ok()) {
-      return std::make_pair(status, assets);
-    }
-    assets.push_back(asset);
-  }
+std::pair<Status, Asset> Client::getAsset(const std::string& symbol) const {
+  auto result = getSharedAsset(symbol);
+  return std::make_pair(result.first, *result.second);
+}
 
-  return std::make_pair(Status(), assets);
+std::pair<Status, std::shared_ptr<const Asset>> Client::getSharedAsset(const std::string& symbol) const {
+  return cached<Asset>("asset/" + symbol, options_.cache_policy.assets_ttl, [&]() { return fetchAsset(symbol); });
 }
 
-std::pair<Status, Asset> Client::getAsset(const std::string& symbol) const {
+std::pair<Status, Asset> Client::fetchAsset(const std::string& symbol) const {
   Asset asset;
 
   auto url = "/v2/assets/" + symbol;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(TradingHost, DataPriority, ReferenceDataEndpoint, url);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -715,10 +980,18 @@ std::pair<Status, Asset> Client::getAsset(const std::string& symbol) const {
 }
 
 std::pair<Status, Clock> Client::getClock() const {
+  auto result = getSharedClock();
+  return std::make_pair(result.first, *result.second);
+}
+
+std::pair<Status, std::shared_ptr<const Clock>> Client::getSharedClock() const {
+  return cached<Clock>("clock", options_.cache_policy.clock_ttl, [&]() { return fetchClock(); });
+}
+
+std::pair<Status, Clock> Client::fetchClock() const {
   Clock clock;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Get("/v2/clock", headers(environment_));
+  auto resp = transport_->Get(TradingHost, DataPriority, ReferenceDataEndpoint, "/v2/clock");
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/clock returned an empty response"), clock);
   }
@@ -734,12 +1007,23 @@ std::pair<Status, Clock> Client::getClock() const {
 }
 
 std::pair<Status, std::vector<Date>> Client::getCalendar(const std::string& start, const std::string& end) const {
+  auto result = getSharedCalendar(start, end);
+  return std::make_pair(result.first, *result.second);
+}
+
+std::pair<Status, std::shared_ptr<const std::vector<Date>>> Client::getSharedCalendar(const std::string& start,
+                                                                                     const std::string& end) const {
+  return cached<std::vector<Date>>(
+      calendarCacheKey(start, end), options_.cache_policy.calendar_ttl, [&]() { return fetchCalendar(start, end); });
+}
+
+std::pair<Status, std::vector<Date>> Client::fetchCalendar(const std::string& start, const std::string& end) const {
   std::vector<Date> dates;
 
   auto url = "/v2/calendar?start=" + start + "&end=" + end;
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  bool shared;
+  auto resp = transport_->Get(TradingHost, DataPriority, ReferenceDataEndpoint, url, false, &shared);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -754,17 +1038,14 @@ std::pair<Status, std::vector<Date>> Client::getCalendar(const std::string& star
 
   DLOG(INFO) << "Response from " << url << ": " << resp->body;
 
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
+  ParseArena arena;
+  auto& d = parseBody(arena, resp, shared);
+  if (d.HasParseError()) {
     return std::make_pair(Status(1, "Received parse error when deserializing calendar JSON"), dates);
   }
   for (auto& o : d.GetArray()) {
     Date date;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    o.Accept(writer);
-    if (auto status = date.fromJSON(s.GetString()); !status.ok()) {
+    if (auto status = date.fromDocument(o); !status.ok()) {
       return std::make_pair(status, dates);
     }
     dates.push_back(date);
@@ -774,11 +1055,21 @@ std::pair<Status, std::vector<Date>> Client::getCalendar(const std::string& star
 }
 
 std::pair<Status, std::vector<Watchlist>> Client::getWatchlists() const {
+  auto result = getSharedWatchlists();
+  return std::make_pair(result.first, *result.second);
+}
+
+std::pair<Status, std::shared_ptr<const std::vector<Watchlist>>> Client::getSharedWatchlists() const {
+  return cached<std::vector<Watchlist>>(
+      "watchlists", options_.cache_policy.watchlists_ttl, [&]() { return fetchWatchlists(); });
+}
+
+std::pair<Status, std::vector<Watchlist>> Client::fetchWatchlists() const {
   std::vector<Watchlist> watchlists;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: /v2/watchlists";
-  auto resp = client.Get("/v2/watchlists", headers(environment_));
+  bool shared;
+  auto resp = transport_->Get(TradingHost, DataPriority, ReferenceDataEndpoint, "/v2/watchlists", false, &shared);
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/watchlists returned an empty response"), watchlists);
   }
@@ -791,17 +1082,14 @@ std::pair<Status, std::vector<Watchlist>> Client::getWatchlists() const {
 
   DLOG(INFO) << "Response from /v2/watchlists: " << resp->body;
 
-  rapidjson::Document d;
-  if (d.Parse(resp->body.c_str()).HasParseError()) {
+  ParseArena arena;
+  auto& d = parseBody(arena, resp, shared);
+  if (d.HasParseError()) {
     return std::make_pair(Status(1, "Received parse error when deserializing watchlists JSON"), watchlists);
   }
   for (auto& o : d.GetArray()) {
     Watchlist watchlist;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    o.Accept(writer);
-    if (auto status = watchlist.fromJSON(s.GetString()); !status.ok()) {
+    if (auto status = watchlist.fromDocument(o); !status.ok()) {
       return std::make_pair(status, watchlists);
     }
     watchlists.push_back(watchlist);
@@ -814,9 +1102,8 @@ std::pair<Status, Watchlist> Client::getWatchlist(const std::string& id) const {
   Watchlist watchlist;
 
   auto url = "/v2/watchlists/" + id;
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(TradingHost, DataPriority, ReferenceDataEndpoint, url);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -857,8 +1144,8 @@ std::pair<Status, Watchlist> Client::createWatchlist(const std::string& name,
 
   DLOG(INFO) << "Sending request body to /v2/watchlists: " << body;
 
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Post("/v2/watchlists", headers(environment_), body, kJSONContentType);
+  auto resp = transport_->Post(TradingHost, DataPriority, ReferenceDataEndpoint, "/v2/watchlists", body);
+  cache_->invalidate("watchlists");
   if (!resp) {
     return std::make_pair(Status(1, "Call to /v2/watchlists returned an empty response"), watchlist);
   }
@@ -898,9 +1185,9 @@ std::pair<Status, Watchlist> Client::updateWatchlist(const std::string& id,
   auto body = s.GetString();
 
   auto url = "/v2/watchlists/" + id;
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Sending request to " << url << ": " << body;
-  auto resp = client.Put(url.c_str(), headers(environment_), body, kJSONContentType);
+  auto resp = transport_->Put(TradingHost, DataPriority, ReferenceDataEndpoint, url, body);
+  cache_->invalidate("watchlists");
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -919,9 +1206,9 @@ std::pair<Status, Watchlist> Client::updateWatchlist(const std::string& id,
 
 Status Client::deleteWatchlist(const std::string& id) const {
   auto url = "/v2/watchlists/" + id;
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Delete(url.c_str(), headers(environment_));
+  auto resp = transport_->Delete(TradingHost, DataPriority, ReferenceDataEndpoint, url);
+  cache_->invalidate("watchlists");
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -950,9 +1237,9 @@ std::pair<Status, Watchlist> Client::addSymbolToWatchlist(const std::string& id,
   auto body = s.GetString();
 
   auto url = "/v2/watchlists/" + id;
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Post(url.c_str(), headers(environment_), body, kJSONContentType);
+  auto resp = transport_->Post(TradingHost, DataPriority, ReferenceDataEndpoint, url, body);
+  cache_->invalidate("watchlists");
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -974,9 +1261,9 @@ std::pair<Status, Watchlist> Client::removeSymbolFromWatchlist(const std::string
   Watchlist watchlist;
 
   auto url = "/v2/watchlists/" + id + "/" + symbol;
-  httplib::SSLClient client(environment_.getAPIBaseURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Delete(url.c_str(), headers(environment_));
+  auto resp = transport_->Delete(TradingHost, DataPriority, ReferenceDataEndpoint, url);
+  cache_->invalidate("watchlists");
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -1033,8 +1320,7 @@ std::pair<Status, PortfolioHistory> Client::getPortfolioHistory(const std::strin
 
   auto url = "/v2/account/portfolio/history" + query_string;
   DLOG(INFO) << "Making request to: " << url;
-  httplib::SSLClient client(environment_.getAPIBaseURL());
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(TradingHost, DataPriority, ReferenceDataEndpoint, url);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -1089,9 +1375,26 @@ std::pair<Status, Bars> Client::getBars(const std::vector<std::string>& symbols,
 
   auto url = "/v1/bars/" + timeframe + "?" + query_string;
 
-  httplib::SSLClient client(environment_.getAPIDataURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  Status parse_status;
+  std::vector<Bar>* symbol_bars = nullptr;
+  auto resp = getIncrementally(
+      *transport_,
+      DataHost,
+      DataPriority,
+      MarketDataEndpoint,
+      url,
+      [&]() { bars.bars.clear(); },
+      [&](const std::string&, const char* json, size_t length) {
+        Bar bar;
+        if (auto status = bar.fromJSON(json, length); !status.ok()) {
+          return status;
+        }
+        symbol_bars->push_back(bar);
+        return Status();
+      },
+      parse_status,
+      [&](const std::string& symbol) { symbol_bars = &bars.bars[SymbolId(symbol)]; });
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -1104,8 +1407,52 @@ std::pair<Status, Bars> Client::getBars(const std::vector<std::string>& symbols,
     return std::make_pair(Status(1, ss.str()), bars);
   }
 
-  DLOG(INFO) << "Response from " << url << ": " << resp->body;
-  return std::make_pair(bars.fromJSON(resp->body), bars);
+  DLOG(INFO) << "Parsed bars for " << bars.bars.size() << " symbols from " << url;
+  return std::make_pair(parse_status, bars);
+}
+
+std::pair<Status, Bars> Client::getBulkBars(const std::vector<std::string>& symbols,
+                                            const std::string& start,
+                                            const std::string& end,
+                                            const std::string& timeframe,
+                                            size_t max_concurrency) const {
+  Bars bars;
+  if (symbols.empty()) {
+    return std::make_pair(Status(), bars);
+  }
+  if (max_concurrency == 0) {
+    max_concurrency = options_.connection_pool_size;
+  }
+  max_concurrency = std::min(max_concurrency, options_.connection_pool_size);
+
+  auto split = splitBarsRange(start, end, timeframe, kMaxBarsLimit);
+  if (!split.first.ok()) {
+    return std::make_pair(split.first, bars);
+  }
+  const auto& windows = split.second;
+  std::vector<std::vector<std::string>> batches;
+  for (size_t i = 0; i < symbols.size(); i += kMaxBarsSymbols) {
+    auto last = std::min(i + kMaxBarsSymbols, symbols.size());
+    batches.emplace_back(symbols.begin() + i, symbols.begin() + last);
+  }
+
+  // Chunks are ordered by batch and then by window, so merging them in order
+  // only appends to each symbol's bars.
+  std::vector<std::pair<Status, Bars>> chunks(batches.size() * windows.size());
+  parallelFor(*executor_, chunks.size(), max_concurrency, [&](size_t i) {
+    const auto& batch = batches[i / windows.size()];
+    const auto& window = windows[i % windows.size()];
+    chunks[i] = getBars(batch, window.first, window.second, "", "", timeframe, kMaxBarsLimit);
+  });
+
+  Status status;
+  for (auto& chunk : chunks) {
+    if (!chunk.first.ok() && status.ok()) {
+      status = chunk.first;
+    }
+    bars.merge(std::move(chunk.second));
+  }
+  return std::make_pair(status, bars);
 }
 
 std::pair<Status, LastTrade> Client::getLastTrade(const std::string& symbol) const {
@@ -1113,9 +1460,8 @@ std::pair<Status, LastTrade> Client::getLastTrade(const std::string& symbol) con
 
   auto url = "/v1/last/stocks/" + symbol;
 
-  httplib::SSLClient client(environment_.getAPIDataURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(DataHost, DataPriority, MarketDataEndpoint, url);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -1137,9 +1483,8 @@ std::pair<Status, LastQuote> Client::getLastQuote(const std::string& symbol) con
 
   auto url = "/v1/last_quote/stocks/" + symbol;
 
-  httplib::SSLClient client(environment_.getAPIDataURL());
   DLOG(INFO) << "Making request to: " << url;
-  auto resp = client.Get(url.c_str(), headers(environment_));
+  auto resp = transport_->Get(DataHost, DataPriority, MarketDataEndpoint, url, true);
   if (!resp) {
     std::ostringstream ss;
     ss << "Call to " << url << " returned an empty response";
@@ -1156,4 +1501,235 @@ std::pair<Status, LastQuote> Client::getLastQuote(const std::string& symbol) con
   return std::make_pair(last_quote.fromJSON(resp->body), last_quote);
 }
 
+Future<Account> Client::getAccountAsync(Callback<Account> callback) const {
+  return async<std::pair<Status, Account>>([=](const Client& client) { return client.getAccount(); }, callback);
+}
+
+Future<AccountConfigurations> Client::getAccountConfigurationsAsync(Callback<AccountConfigurations> callback) const {
+  return async<std::pair<Status, AccountConfigurations>>(
+      [=](const Client& client) { return client.getAccountConfigurations(); }, callback);
+}
+
+Future<std::vector<std::variant<TradeActivity, NonTradeActivity>>> Client::getAccountActivityAsync(
+    const std::vector<std::string>& activity_types,
+    Callback<std::vector<std::variant<TradeActivity, NonTradeActivity>>> callback) const {
+  return async<std::pair<Status, std::vector<std::variant<TradeActivity, NonTradeActivity>>>>(
+      [=](const Client& client) { return client.getAccountActivity(activity_types); }, callback);
+}
+
+Future<AccountConfigurations> Client::updateAccountConfigurationsAsync(const bool no_shorting,
+                                                                       const std::string& dtbp_check,
+                                                                       const std::string& trade_confirm_email,
+                                                                       const bool suspend_trade,
+                                                                       Callback<AccountConfigurations> callback) const {
+  return async<std::pair<Status, AccountConfigurations>>(
+      [=](const Client& client) {
+        return client.updateAccountConfigurations(no_shorting, dtbp_check, trade_confirm_email, suspend_trade);
+      },
+      callback);
+}
+
+Future<std::vector<Order>> Client::getOrdersAsync(const ActionStatus status,
+                                                  const int limit,
+                                                  const std::string& after,
+                                                  const std::string& until,
+                                                  const OrderDirection direction,
+                                                  const bool nested,
+                                                  Callback<std::vector<Order>> callback) const {
+  return async<std::pair<Status, std::vector<Order>>>(
+      [=](const Client& client) { return client.getOrders(status, limit, after, until, direction, nested); }, callback);
+}
+
+Future<Order> Client::getOrderAsync(const std::string& id, const bool nested, Callback<Order> callback) const {
+  return async<std::pair<Status, Order>>([=](const Client& client) { return client.getOrder(id, nested); }, callback);
+}
+
+Future<Order> Client::getOrderByClientOrderIDAsync(const std::string& client_order_id, Callback<Order> callback) const {
+  return async<std::pair<Status, Order>>(
+      [=](const Client& client) { return client.getOrderByClientOrderID(client_order_id); }, callback);
+}
+
+Future<Order> Client::submitOrderAsync(const std::string& symbol,
+                                       const int quantity,
+                                       const OrderSide side,
+                                       const OrderType type,
+                                       const OrderTimeInForce tif,
+                                       const Decimal& limit_price,
+                                       const Decimal& stop_price,
+                                       const bool extended_hours,
+                                       const std::string& client_order_id,
+                                       const OrderClass order_class,
+                                       TakeProfitParams* take_profit_params,
+                                       StopLossParams* stop_loss_params,
+                                       Callback<Order> callback) const {
+  // The bracket parameters are copied since the caller's pointers may not
+  // outlive the call.
+  auto take_profit = take_profit_params ? std::make_shared<TakeProfitParams>(*take_profit_params) : nullptr;
+  auto stop_loss = stop_loss_params ? std::make_shared<StopLossParams>(*stop_loss_params) : nullptr;
+  return async<std::pair<Status, Order>>(
+      [=](const Client& client) {
+        return client.submitOrder(symbol,
+                                  quantity,
+                                  side,
+                                  type,
+                                  tif,
+                                  limit_price,
+                                  stop_price,
+                                  extended_hours,
+                                  client_order_id,
+                                  order_class,
+                                  take_profit.get(),
+                                  stop_loss.get());
+      },
+      callback);
+}
+
+Future<Order> Client::submitOrderAsync(const OrderRequest& request, Callback<Order> callback) const {
+  return async<std::pair<Status, Order>>([=](const Client& client) { return client.submitOrder(request); }, callback);
+}
+
+Future<Order> Client::replaceOrderAsync(const std::string& id,
+                                        const int quantity,
+                                        const OrderTimeInForce tif,
+                                        const Decimal& limit_price,
+                                        const Decimal& stop_price,
+                                        const std::string& client_order_id,
+                                        Callback<Order> callback) const {
+  return async<std::pair<Status, Order>>(
+      [=](const Client& client) {
+        return client.replaceOrder(id, quantity, tif, limit_price, stop_price, client_order_id);
+      },
+      callback);
+}
+
+Future<std::vector<Order>> Client::cancelOrdersAsync(Callback<std::vector<Order>> callback) const {
+  return async<std::pair<Status, std::vector<Order>>>(
+      [=](const Client& client) { return client.cancelOrders(); }, callback);
+}
+
+Future<Order> Client::cancelOrderAsync(const std::string& id, Callback<Order> callback) const {
+  return async<std::pair<Status, Order>>([=](const Client& client) { return client.cancelOrder(id); }, callback);
+}
+
+Future<std::vector<Position>> Client::getPositionsAsync(Callback<std::vector<Position>> callback) const {
+  return async<std::pair<Status, std::vector<Position>>>(
+      [=](const Client& client) { return client.getPositions(); }, callback);
+}
+
+Future<Position> Client::getPositionAsync(const std::string& symbol, Callback<Position> callback) const {
+  return async<std::pair<Status, Position>>([=](const Client& client) { return client.getPosition(symbol); }, callback);
+}
+
+Future<std::vector<Position>> Client::closePositionsAsync(Callback<std::vector<Position>> callback) const {
+  return async<std::pair<Status, std::vector<Position>>>(
+      [=](const Client& client) { return client.closePositions(); }, callback);
+}
+
+Future<Position> Client::closePositionAsync(const std::string& symbol, Callback<Position> callback) const {
+  return async<std::pair<Status, Position>>(
+      [=](const Client& client) { return client.closePosition(symbol); }, callback);
+}
+
+Future<std::vector<Asset>> Client::getAssetsAsync(const ActionStatus asset_status,
+                                                  const AssetClass asset_class,
+                                                  Callback<std::vector<Asset>> callback) const {
+  return async<std::pair<Status, std::vector<Asset>>>(
+      [=](const Client& client) { return client.getAssets(asset_status, asset_class); }, callback);
+}
+
+Future<Asset> Client::getAssetAsync(const std::string& symbol, Callback<Asset> callback) const {
+  return async<std::pair<Status, Asset>>([=](const Client& client) { return client.getAsset(symbol); }, callback);
+}
+
+Future<Clock> Client::getClockAsync(Callback<Clock> callback) const {
+  return async<std::pair<Status, Clock>>([=](const Client& client) { return client.getClock(); }, callback);
+}
+
+Future<std::vector<Date>> Client::getCalendarAsync(const std::string& start,
+                                                   const std::string& end,
+                                                   Callback<std::vector<Date>> callback) const {
+  return async<std::pair<Status, std::vector<Date>>>(
+      [=](const Client& client) { return client.getCalendar(start, end); }, callback);
+}
+
+Future<std::vector<Watchlist>> Client::getWatchlistsAsync(Callback<std::vector<Watchlist>> callback) const {
+  return async<std::pair<Status, std::vector<Watchlist>>>(
+      [=](const Client& client) { return client.getWatchlists(); }, callback);
+}
+
+Future<Watchlist> Client::getWatchlistAsync(const std::string& id, Callback<Watchlist> callback) const {
+  return async<std::pair<Status, Watchlist>>([=](const Client& client) { return client.getWatchlist(id); }, callback);
+}
+
+Future<Watchlist> Client::createWatchlistAsync(const std::string& name,
+                                               const std::vector<std::string>& symbols,
+                                               Callback<Watchlist> callback) const {
+  return async<std::pair<Status, Watchlist>>(
+      [=](const Client& client) { return client.createWatchlist(name, symbols); }, callback);
+}
+
+Future<Watchlist> Client::updateWatchlistAsync(const std::string& id,
+                                               const std::string& name,
+                                               const std::vector<std::string>& symbols,
+                                               Callback<Watchlist> callback) const {
+  return async<std::pair<Status, Watchlist>>(
+      [=](const Client& client) { return client.updateWatchlist(id, name, symbols); }, callback);
+}
+
+std::future<Status> Client::deleteWatchlistAsync(const std::string& id,
+                                                 std::function<void(const Status&)> callback) const {
+  return async<Status>([=](const Client& client) { return client.deleteWatchlist(id); }, callback);
+}
+
+Future<Watchlist> Client::addSymbolToWatchlistAsync(const std::string& id,
+                                                    const std::string& symbol,
+                                                    Callback<Watchlist> callback) const {
+  return async<std::pair<Status, Watchlist>>(
+      [=](const Client& client) { return client.addSymbolToWatchlist(id, symbol); }, callback);
+}
+
+Future<Watchlist> Client::removeSymbolFromWatchlistAsync(const std::string& id,
+                                                         const std::string& symbol,
+                                                         Callback<Watchlist> callback) const {
+  return async<std::pair<Status, Watchlist>>(
+      [=](const Client& client) { return client.removeSymbolFromWatchlist(id, symbol); }, callback);
+}
+
+Future<PortfolioHistory> Client::getPortfolioHistoryAsync(const std::string& period,
+                                                          const std::string& timeframe,
+                                                          const std::string& date_end,
+                                                          const bool extended_hours,
+                                                          Callback<PortfolioHistory> callback) const {
+  return async<std::pair<Status, PortfolioHistory>>(
+      [=](const Client& client) {
+        return client.getPortfolioHistory(period, timeframe, date_end, extended_hours);
+      },
+      callback);
+}
+
+Future<Bars> Client::getBarsAsync(const std::vector<std::string>& symbols,
+                                  const std::string& start,
+                                  const std::string& end,
+                                  const std::string& after,
+                                  const std::string& until,
+                                  const std::string& timeframe,
+                                  const uint limit,
+                                  Callback<Bars> callback) const {
+  return async<std::pair<Status, Bars>>(
+      [=](const Client& client) {
+        return client.getBars(symbols, start, end, after, until, timeframe, limit);
+      },
+      callback);
+}
+
+Future<LastTrade> Client::getLastTradeAsync(const std::string& symbol, Callback<LastTrade> callback) const {
+  return async<std::pair<Status, LastTrade>>(
+      [=](const Client& client) { return client.getLastTrade(symbol); }, callback);
+}
+
+Future<LastQuote> Client::getLastQuoteAsync(const std::string& symbol, Callback<LastQuote> callback) const {
+  return async<std::pair<Status, LastQuote>>(
+      [=](const Client& client) { return client.getLastQuote(symbol); }, callback);
+}
+
 } // namespace alpaca
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
 #include <string>
 #include <utility>
 #include <variant>
@@ -11,16 +15,36 @@
 #include "alpaca/calendar.h"
 #include "alpaca/clock.h"
 #include "alpaca/config.h"
+#include "alpaca/decimal.h"
 #include "alpaca/order.h"
+#include "alpaca/paginated.h"
 #include "alpaca/portfolio.h"
 #include "alpaca/position.h"
 #include "alpaca/quote.h"
+#include "alpaca/rate_limiter.h"
 #include "alpaca/status.h"
 #include "alpaca/trade.h"
 #include "alpaca/watchlist.h"
 
 namespace alpaca {
 
+class Executor;
+class ResponseCache;
+class Transport;
+
+/**
+ * @brief The result of an asynchronous Client call.
+ */
+template <typename T>
+using Future = std::future<std::pair<Status, T>>;
+
+/**
+ * @brief A function which is invoked with the result of an asynchronous Client
+ * call on one of the client's I/O threads.
+ */
+template <typename T>
+using Callback = std::function<void(const std::pair<Status, T>&)>;
+
 /**
  * @brief The API client object for interacting with the Alpaca Trading API.
  *
@@ -38,8 +62,11 @@ class Client {
  public:
   /**
    * @brief The primary constructor.
+   *
+   * Copies of a Client share the same underlying connection pools and rate
+   * limiter.
    */
-  explicit Client(Environment& environment);
+  explicit Client(Environment& environment, const ClientOptions& options = ClientOptions());
 
   /**
    * @brief The default constructor of Client should never be used.
@@ -114,6 +141,33 @@ class Client {
   std::pair<Status, std::vector<std::variant<TradeActivity, NonTradeActivity>>> getAccountActivity(
       const std::vector<std::string>& activity_types = {}) const;
 
+  /**
+   * @brief Lazily iterate over every page of Alpaca account activity.
+   *
+   * Unlike getAccountActivity(), which only returns the first page, the range
+   * follows page tokens until the activity is exhausted, prefetching each page
+   * while the previous one is processed.
+   *
+   * @code{.cpp}
+   *   auto activities = client.iterateAccountActivity({"FILL"});
+   *   for (const auto& activity : activities) {
+   *     auto fill = std::get<alpaca::TradeActivity>(activity);
+   *     LOG(INFO) << fill.symbol << ": " << fill.qty;
+   *   }
+   *   if (!activities.status().ok()) {
+   *     LOG(ERROR) << "Error getting account activity: "
+   *                << activities.status().getMessage();
+   *   }
+   * @endcode
+   *
+   * @param page_size The number of activities to fetch per request, at most
+   * 100.
+   */
+  Paginated<std::variant<TradeActivity, NonTradeActivity>> iterateAccountActivity(
+      const std::vector<std::string>& activity_types = {},
+      const OrderDirection direction = OrderDirection::Descending,
+      const int page_size = 100) const;
+
   /**
    * @brief Update Alpaca account configuration information.
    *
@@ -160,6 +214,36 @@ class Client {
                                                   const OrderDirection = OrderDirection::Descending,
                                                   const bool nested = false) const;
 
+  /**
+   * @brief Lazily iterate over every submitted Alpaca order between after and
+   * until.
+   *
+   * Pages are requested with getOrders() by moving the until (or, when
+   * ascending, the after) bound to the submission time of the last order of
+   * the previous page. Orders submitted at that same time are requested again
+   * and those already returned are skipped, so no order is lost or repeated
+   * when several share a timestamp. Each page is prefetched while the previous
+   * one is processed.
+   *
+   * @code{.cpp}
+   *   auto orders = client.iterateOrders(alpaca::ActionStatus::All);
+   *   for (const auto& order : orders) {
+   *     LOG(INFO) << order.client_order_id << ": " << order.status;
+   *   }
+   *   if (!orders.status().ok()) {
+   *     LOG(ERROR) << "Error getting orders: " << orders.status().getMessage();
+   *   }
+   * @endcode
+   *
+   * @param page_size The number of orders to fetch per request, at most 500.
+   */
+  Paginated<Order> iterateOrders(const ActionStatus status = ActionStatus::Open,
+                                 const std::string& after = "",
+                                 const std::string& until = "",
+                                 const OrderDirection direction = OrderDirection::Descending,
+                                 const bool nested = false,
+                                 const int page_size = 500) const;
+
   /**
    * @brief Fetch a specific Alpaca order.
    *
@@ -229,14 +313,74 @@ class Client {
                                        const OrderSide side,
                                        const OrderType type,
                                        const OrderTimeInForce tif,
-                                       const std::string& limit_price = "",
-                                       const std::string& stop_price = "",
+                                       const Decimal& limit_price = Decimal(),
+                                       const Decimal& stop_price = Decimal(),
                                        const bool extended_hours = false,
                                        const std::string& client_order_id = "",
                                        const OrderClass order_class = OrderClass::Simple,
                                        TakeProfitParams* take_profit_params = nullptr,
                                        StopLossParams* stop_loss_params = nullptr) const;
 
+  /**
+   * @brief Submit an Alpaca order described by an alpaca::OrderRequest.
+   *
+   * @code{.cpp}
+   *   auto request = alpaca::OrderRequest();
+   *   request.symbol = "NFLX";
+   *   request.quantity = 10;
+   *   auto resp = client.submitOrder(request);
+   *   if (auto status = resp.first; !status.ok()) {
+   *     LOG(ERROR) << "Error submitting order: "
+   *                << status.getMessage();
+   *     return status.getCode();
+   *   }
+   *   auto order = resp.second;
+   *   LOG(INFO) << "Client Order Identifier: " << order.client_order_id;
+   * @endcode
+   *
+   * @return a std::pair where the first elemennt is a Status indicating the
+   * success or faliure of the operation and the second element is the newly
+   * created alpaca::Order object.
+   */
+  std::pair<Status, Order> submitOrder(const OrderRequest& request) const;
+
+  /**
+   * @brief Submit many Alpaca orders concurrently.
+   *
+   * @code{.cpp}
+   *   std::vector<alpaca::OrderRequest> requests;
+   *   for (const auto& symbol : {"AAPL", "GOOG", "NFLX"}) {
+   *     auto request = alpaca::OrderRequest();
+   *     request.symbol = symbol;
+   *     request.quantity = 10;
+   *     requests.push_back(request);
+   *   }
+   *   auto results = client.submitOrders(requests);
+   *   for (size_t i = 0; i < results.size(); ++i) {
+   *     if (auto status = results[i].first; !status.ok()) {
+   *       LOG(ERROR) << "Error submitting order for " << requests[i].symbol
+   *                  << ": " << status.getMessage();
+   *     }
+   *   }
+   * @endcode
+   *
+   * Orders are sent from the calling thread and from the client's I/O
+   * threads, over connections from the pool.
+   *
+   * @param requests The orders to submit.
+   * @param max_concurrency The maximum number of orders in flight at once. If
+   * zero, ClientOptions::order_concurrency is used. It is capped at
+   * ClientOptions::connection_pool_size, so that every order is sent over a
+   * pooled connection.
+   *
+   * @return a vector with one std::pair per request, in the same order as the
+   * requests, where the first element is a Status indicating the success or
+   * failure of that submission and the second element is the newly created
+   * alpaca::Order object.
+   */
+  std::vector<std::pair<Status, Order>> submitOrders(const std::vector<OrderRequest>& requests,
+                                                     size_t max_concurrency = 0) const;
+
   /**
    * @brief Replace an Alpaca order.
    *
@@ -262,8 +406,8 @@ class Client {
   std::pair<Status, Order> replaceOrder(const std::string& id,
                                         const int quantity,
                                         const OrderTimeInForce tif,
-                                        const std::string& limit_price = "",
-                                        const std::string& stop_price = "",
+                                        const Decimal& limit_price = Decimal(),
+                                        const Decimal& stop_price = Decimal(),
                                         const std::string& client_order_id = "") const;
 
   /**
@@ -407,6 +551,19 @@ class Client {
   std::pair<Status, std::vector<Asset>> getAssets(const ActionStatus asset_status = ActionStatus::Active,
                                                   const AssetClass asset_class = AssetClass::USEquity) const;
 
+  /**
+   * @brief Fetch all open Alpaca assets as a shared immutable object.
+   *
+   * Results are served from the client's cache while
+   * CachePolicy::assets_ttl has not elapsed, in which case no copy of the
+   * assets is made. Every asset is also cached for getAsset().
+   *
+   * @see getAssets()
+   */
+  std::pair<Status, std::shared_ptr<const std::vector<Asset>>> getSharedAssets(
+      const ActionStatus asset_status = ActionStatus::Active,
+      const AssetClass asset_class = AssetClass::USEquity) const;
+
   /**
    * @brief Fetch an asset for a given symbol.
    *
@@ -427,6 +584,16 @@ class Client {
    */
   std::pair<Status, Asset> getAsset(const std::string& symbol) const;
 
+  /**
+   * @brief Fetch an asset for a given symbol as a shared immutable object.
+   *
+   * Results are served from the client's cache while
+   * CachePolicy::assets_ttl has not elapsed.
+   *
+   * @see getAsset()
+   */
+  std::pair<Status, std::shared_ptr<const Asset>> getSharedAsset(const std::string& symbol) const;
+
   /**
    * @brief Fetch the market clock.
    *
@@ -447,6 +614,16 @@ class Client {
    */
   std::pair<Status, Clock> getClock() const;
 
+  /**
+   * @brief Fetch the market clock as a shared immutable object.
+   *
+   * Results are served from the client's cache while CachePolicy::clock_ttl
+   * has not elapsed, so the timestamp of a cached clock may be stale.
+   *
+   * @see getClock()
+   */
+  std::pair<Status, std::shared_ptr<const Clock>> getSharedClock() const;
+
   /**
    * @brief Fetch calendar data.
    *
@@ -461,7 +638,7 @@ class Client {
    *   for (const auto& date : dates) {
    *     LOG(INFO) << "Market opened at " << date.open
    *               << " and closed at " << date.close
-   *               << " on " << date.date;
+   *               << " on " << date.date.toDateString();
    *   }
    * @endcode
    *
@@ -471,6 +648,17 @@ class Client {
    */
   std::pair<Status, std::vector<Date>> getCalendar(const std::string& start, const std::string& end) const;
 
+  /**
+   * @brief Fetch calendar data as a shared immutable object.
+   *
+   * Results are served from the client's cache while
+   * CachePolicy::calendar_ttl has not elapsed.
+   *
+   * @see getCalendar()
+   */
+  std::pair<Status, std::shared_ptr<const std::vector<Date>>> getSharedCalendar(const std::string& start,
+                                                                               const std::string& end) const;
+
   /**
    * @brief Fetch watchlists.
    *
@@ -491,6 +679,17 @@ class Client {
    */
   std::pair<Status, std::vector<Watchlist>> getWatchlists() const;
 
+  /**
+   * @brief Fetch watchlists as a shared immutable object.
+   *
+   * Results are served from the client's cache while
+   * CachePolicy::watchlists_ttl has not elapsed. Modifying a watchlist through
+   * this client invalidates the cached watchlists.
+   *
+   * @see getWatchlists()
+   */
+  std::pair<Status, std::shared_ptr<const std::vector<Watchlist>>> getSharedWatchlists() const;
+
   /**
    * @brief Fetch a watchlist by ID.
    *
@@ -662,6 +861,40 @@ class Client {
                                   const std::string& timeframe = "1D",
                                   const uint limit = 100) const;
 
+  /**
+   * @brief Fetch every bar of a timeframe for any number of symbols over any
+   * time range.
+   *
+   * Unlike getBars(), the symbols and the range are split into as many
+   * requests as the endpoint's limits require (kMaxBarsSymbols symbols and
+   * kMaxBarsLimit bars per symbol). The requests are sent concurrently over
+   * pooled connections and the bars of each symbol are merged in timestamp
+   * order.
+   *
+   * @code{.cpp}
+   *   auto resp = client.getBulkBars(symbols, "2019-01-01T00:00:00Z", "2019-12-31T23:59:59Z", "1Min");
+   *   if (auto status = resp.first; !status.ok()) {
+   *     LOG(ERROR) << "Error getting bars: " << status.getMessage();
+   *     return status.getCode();
+   *   }
+   * @endcode
+   *
+   * @param start The start of the range, as an RFC3339 timestamp or a date.
+   * @param end The end of the range, as an RFC3339 timestamp or a date.
+   * @param max_concurrency The most requests to have in flight at once. Zero
+   * uses, and larger values are capped at, ClientOptions::connection_pool_size.
+   *
+   * @return a std::pair where the first elemennt is a Status indicating the
+   * success or faliure of the operation and the second element is an instance
+   * of an alpaca::Bars object. On failure it holds the bars of the requests
+   * which succeeded.
+   */
+  std::pair<Status, Bars> getBulkBars(const std::vector<std::string>& symbols,
+                                      const std::string& start,
+                                      const std::string& end,
+                                      const std::string& timeframe = "1D",
+                                      size_t max_concurrency = 0) const;
+
   /**
    * @brief Fetch last trade details for a symbol.
    *
@@ -702,7 +935,458 @@ class Client {
    */
   std::pair<Status, LastQuote> getLastQuote(const std::string& symbol) const;
 
+  /**
+   * @brief Asynchronously fetch Alpaca account information.
+   *
+   * @see getAccount()
+   *
+   * @return a std::future which resolves to the result of getAccount().
+   */
+  Future<Account> getAccountAsync(Callback<Account> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch Alpaca account configuration information.
+   *
+   * @see getAccountConfigurations()
+   *
+   * @return a std::future which resolves to the result of getAccountConfigurations().
+   */
+  Future<AccountConfigurations> getAccountConfigurationsAsync(Callback<AccountConfigurations> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch Alpaca account activity.
+   *
+   * @see getAccountActivity()
+   *
+   * @return a std::future which resolves to the result of getAccountActivity().
+   */
+  Future<std::vector<std::variant<TradeActivity, NonTradeActivity>>> getAccountActivityAsync(
+      const std::vector<std::string>& activity_types = {},
+      Callback<std::vector<std::variant<TradeActivity, NonTradeActivity>>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously update Alpaca account configuration information.
+   *
+   * @see updateAccountConfigurations()
+   *
+   * @return a std::future which resolves to the result of updateAccountConfigurations().
+   */
+  Future<AccountConfigurations> updateAccountConfigurationsAsync(
+      const bool no_shorting,
+      const std::string& dtbp_check,
+      const std::string& trade_confirm_email,
+      const bool suspend_trade,
+      Callback<AccountConfigurations> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch submitted Alpaca orders.
+   *
+   * @see getOrders()
+   *
+   * @return a std::future which resolves to the result of getOrders().
+   */
+  Future<std::vector<Order>> getOrdersAsync(const ActionStatus status = ActionStatus::Open,
+                                            const int limit = 50,
+                                            const std::string& after = "",
+                                            const std::string& until = "",
+                                            const OrderDirection direction = OrderDirection::Descending,
+                                            const bool nested = false,
+                                            Callback<std::vector<Order>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch a specific Alpaca order.
+   *
+   * @see getOrder()
+   *
+   * @return a std::future which resolves to the result of getOrder().
+   */
+  Future<Order> getOrderAsync(const std::string& id,
+                              const bool nested = false,
+                              Callback<Order> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch a specific Alpaca order by client order ID.
+   *
+   * @see getOrderByClientOrderID()
+   *
+   * @return a std::future which resolves to the result of getOrderByClientOrderID().
+   */
+  Future<Order> getOrderByClientOrderIDAsync(const std::string& client_order_id,
+                                             Callback<Order> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously submit an Alpaca order.
+   *
+   * @see submitOrder()
+   *
+   * @return a std::future which resolves to the result of submitOrder().
+   */
+  Future<Order> submitOrderAsync(const std::string& symbol,
+                                 const int quantity,
+                                 const OrderSide side,
+                                 const OrderType type,
+                                 const OrderTimeInForce tif,
+                                 const Decimal& limit_price = Decimal(),
+                                 const Decimal& stop_price = Decimal(),
+                                 const bool extended_hours = false,
+                                 const std::string& client_order_id = "",
+                                 const OrderClass order_class = OrderClass::Simple,
+                                 TakeProfitParams* take_profit_params = nullptr,
+                                 StopLossParams* stop_loss_params = nullptr,
+                                 Callback<Order> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously submit an Alpaca order described by an alpaca::OrderRequest.
+   *
+   * @see submitOrder()
+   *
+   * @return a std::future which resolves to the result of submitOrder().
+   */
+  Future<Order> submitOrderAsync(const OrderRequest& request, Callback<Order> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously replace an Alpaca order.
+   *
+   * @see replaceOrder()
+   *
+   * @return a std::future which resolves to the result of replaceOrder().
+   */
+  Future<Order> replaceOrderAsync(const std::string& id,
+                                  const int quantity,
+                                  const OrderTimeInForce tif,
+                                  const Decimal& limit_price = Decimal(),
+                                  const Decimal& stop_price = Decimal(),
+                                  const std::string& client_order_id = "",
+                                  Callback<Order> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously cancel all Alpaca orders.
+   *
+   * @see cancelOrders()
+   *
+   * @return a std::future which resolves to the result of cancelOrders().
+   */
+  Future<std::vector<Order>> cancelOrdersAsync(Callback<std::vector<Order>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously cancel a specific Alpaca order.
+   *
+   * @see cancelOrder()
+   *
+   * @return a std::future which resolves to the result of cancelOrder().
+   */
+  Future<Order> cancelOrderAsync(const std::string& id, Callback<Order> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch all open Alpaca positions.
+   *
+   * @see getPositions()
+   *
+   * @return a std::future which resolves to the result of getPositions().
+   */
+  Future<std::vector<Position>> getPositionsAsync(Callback<std::vector<Position>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch a position for a given symbol.
+   *
+   * @see getPosition()
+   *
+   * @return a std::future which resolves to the result of getPosition().
+   */
+  Future<Position> getPositionAsync(const std::string& symbol, Callback<Position> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously close (liquidate) all Alpaca positions.
+   *
+   * @see closePositions()
+   *
+   * @return a std::future which resolves to the result of closePositions().
+   */
+  Future<std::vector<Position>> closePositionsAsync(Callback<std::vector<Position>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously close (liquidate) the position for a given symbol.
+   *
+   * @see closePosition()
+   *
+   * @return a std::future which resolves to the result of closePosition().
+   */
+  Future<Position> closePositionAsync(const std::string& symbol, Callback<Position> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch all open Alpaca assets.
+   *
+   * @see getAssets()
+   *
+   * @return a std::future which resolves to the result of getAssets().
+   */
+  Future<std::vector<Asset>> getAssetsAsync(const ActionStatus asset_status = ActionStatus::Active,
+                                            const AssetClass asset_class = AssetClass::USEquity,
+                                            Callback<std::vector<Asset>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch an asset for a given symbol.
+   *
+   * @see getAsset()
+   *
+   * @return a std::future which resolves to the result of getAsset().
+   */
+  Future<Asset> getAssetAsync(const std::string& symbol, Callback<Asset> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch the market clock.
+   *
+   * @see getClock()
+   *
+   * @return a std::future which resolves to the result of getClock().
+   */
+  Future<Clock> getClockAsync(Callback<Clock> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch calendar data.
+   *
+   * @see getCalendar()
+   *
+   * @return a std::future which resolves to the result of getCalendar().
+   */
+  Future<std::vector<Date>> getCalendarAsync(const std::string& start,
+                                             const std::string& end,
+                                             Callback<std::vector<Date>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch watchlists.
+   *
+   * @see getWatchlists()
+   *
+   * @return a std::future which resolves to the result of getWatchlists().
+   */
+  Future<std::vector<Watchlist>> getWatchlistsAsync(Callback<std::vector<Watchlist>> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch a watchlist by ID.
+   *
+   * @see getWatchlist()
+   *
+   * @return a std::future which resolves to the result of getWatchlist().
+   */
+  Future<Watchlist> getWatchlistAsync(const std::string& id, Callback<Watchlist> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously create a watchlist.
+   *
+   * @see createWatchlist()
+   *
+   * @return a std::future which resolves to the result of createWatchlist().
+   */
+  Future<Watchlist> createWatchlistAsync(const std::string& name,
+                                         const std::vector<std::string>& symbols,
+                                         Callback<Watchlist> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously update a watchlist.
+   *
+   * @see updateWatchlist()
+   *
+   * @return a std::future which resolves to the result of updateWatchlist().
+   */
+  Future<Watchlist> updateWatchlistAsync(const std::string& id,
+                                         const std::string& name,
+                                         const std::vector<std::string>& symbols,
+                                         Callback<Watchlist> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously delete a watchlist.
+   *
+   * @see deleteWatchlist()
+   *
+   * @return a std::future which resolves to the result of deleteWatchlist().
+   */
+  std::future<Status> deleteWatchlistAsync(const std::string& id,
+                                           std::function<void(const Status&)> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously add an asset to a watchlist.
+   *
+   * @see addSymbolToWatchlist()
+   *
+   * @return a std::future which resolves to the result of addSymbolToWatchlist().
+   */
+  Future<Watchlist> addSymbolToWatchlistAsync(const std::string& id,
+                                              const std::string& symbol,
+                                              Callback<Watchlist> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously remove an asset from a watchlist.
+   *
+   * @see removeSymbolFromWatchlist()
+   *
+   * @return a std::future which resolves to the result of removeSymbolFromWatchlist().
+   */
+  Future<Watchlist> removeSymbolFromWatchlistAsync(const std::string& id,
+                                                   const std::string& symbol,
+                                                   Callback<Watchlist> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch portfolio history data.
+   *
+   * @see getPortfolioHistory()
+   *
+   * @return a std::future which resolves to the result of getPortfolioHistory().
+   */
+  Future<PortfolioHistory> getPortfolioHistoryAsync(const std::string& period = "",
+                                                    const std::string& timeframe = "",
+                                                    const std::string& date_end = "",
+                                                    const bool extended_hours = false,
+                                                    Callback<PortfolioHistory> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch historical performance data.
+   *
+   * @see getBars()
+   *
+   * @return a std::future which resolves to the result of getBars().
+   */
+  Future<Bars> getBarsAsync(const std::vector<std::string>& symbols,
+                            const std::string& start,
+                            const std::string& end,
+                            const std::string& after = "",
+                            const std::string& until = "",
+                            const std::string& timeframe = "1D",
+                            const uint limit = 100,
+                            Callback<Bars> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch last trade details for a symbol.
+   *
+   * @see getLastTrade()
+   *
+   * @return a std::future which resolves to the result of getLastTrade().
+   */
+  Future<LastTrade> getLastTradeAsync(const std::string& symbol, Callback<LastTrade> callback = nullptr) const;
+
+  /**
+   * @brief Asynchronously fetch last quote details for a symbol.
+   *
+   * @see getLastQuote()
+   *
+   * @return a std::future which resolves to the result of getLastQuote().
+   */
+  Future<LastQuote> getLastQuoteAsync(const std::string& symbol, Callback<LastQuote> callback = nullptr) const;
+
+  /**
+   * @brief The client-side rate limiter which every request goes through.
+   *
+   * Requests are sent in priority order: cancellations first, then order
+   * submission and replacement, then account and position reads, and finally
+   * market data and reference data. The queue depth of each lane can be used
+   * to monitor how far behind the client is.
+   *
+   * @code{.cpp}
+   *   auto& limiter = client.getRateLimiter();
+   *   LOG(INFO) << "Market data requests waiting: " << limiter.queueDepth(alpaca::DataPriority);
+   * @endcode
+   */
+  RateLimiter& getRateLimiter() const;
+
+  /**
+   * @brief Open and exercise connections to the trading API so that the next
+   * requests do not pay for a TCP connect and TLS handshake.
+   *
+   * Schedule this shortly before latency-critical periods such as the market
+   * open. Each connection sends a GET /v2/clock, which counts against the rate
+   * limit at the lowest priority. Connections are only warmed while budget is
+   * available immediately, so that warming never holds up other requests.
+   *
+   * @code{.cpp}
+   *   if (auto status = client.warmup(4); !status.ok()) {
+   *     LOG(WARNING) << "Error warming up connections: " << status.getMessage();
+   *   }
+   * @endcode
+   *
+   * @param connections The number of connections to warm, or zero for
+   * ClientOptions::warm_connections (and at least one).
+   */
+  Status warmup(const size_t connections = 0) const;
+
+  /**
+   * @brief Drop every response cached by the client and its copies.
+   *
+   * @see CachePolicy
+   */
+  void invalidateCache() const;
+
+  /**
+   * @brief Fetch the assets and calendar of SnapshotPolicy and persist them to
+   * the snapshot file.
+   *
+   * This is called in the background when the client is constructed, and can
+   * be called again to keep a long-running process's snapshot fresh. The
+   * fetched data is also served by getAssets() and getCalendar() until the
+   * snapshot's max_age elapses.
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status refreshSnapshot() const;
+
  private:
-  Environment environment_;
+  /**
+   * @brief Run a call against a copy of this client on the I/O executor.
+   */
+  template <typename T>
+  std::future<T> async(std::function<T(const Client&)> call, std::function<void(const T&)> callback) const;
+
+  /**
+   * @brief Serve a value from the response cache, or fetch and cache it.
+   *
+   * Values are only cached when the fetch succeeds and ttl is non-zero, but
+   * values cached by other means, such as a snapshot, are always served.
+   */
+  template <typename T>
+  std::pair<Status, std::shared_ptr<const T>> cached(const std::string& key,
+                                                     const std::chrono::milliseconds ttl,
+                                                     const std::function<std::pair<Status, T>()>& fetch) const;
+
+  std::pair<Status, std::vector<Asset>> fetchAssets(const ActionStatus asset_status,
+                                                    const AssetClass asset_class) const;
+  std::pair<Status, Asset> fetchAsset(const std::string& symbol) const;
+  std::pair<Status, Clock> fetchClock() const;
+  std::pair<Status, std::vector<Date>> fetchCalendar(const std::string& start, const std::string& end) const;
+  std::pair<Status, std::vector<Watchlist>> fetchWatchlists() const;
+
+  /**
+   * @brief Fetch a page of account activity. A page_size of 0 leaves the page
+   * size up to the API.
+   */
+  std::pair<Status, std::vector<std::variant<TradeActivity, NonTradeActivity>>> fetchAccountActivity(
+      const std::vector<std::string>& activity_types,
+      const OrderDirection direction,
+      const int page_size,
+      const std::string& page_token) const;
+
+  /**
+   * @brief Cache a list of assets along with each of its assets.
+   */
+  void cacheAssets(const std::string& key,
+                   const std::shared_ptr<const std::vector<Asset>>& assets,
+                   const std::chrono::milliseconds ttl) const;
+
+  /**
+   * @brief Serve the snapshot of SnapshotPolicy from the cache if it is fresh.
+   */
+  void loadSnapshot() const;
+
+ private:
+  /// Every member is cheap to copy, since asynchronous calls copy the client
+  ClientOptions options_;
+
+  /// The authentication headers, connection pools and rate limiter which
+  /// every request goes through
+  std::shared_ptr<Transport> transport_;
+
+  /// The I/O threads which run asynchronous calls
+  std::shared_ptr<Executor> executor_;
+
+  /// Parsed responses of slowly changing endpoints
+  std::shared_ptr<ResponseCache> cache_;
 };
 } // namespace alpaca
\ No newline at end of file
@@ -12,7 +12,7 @@ TEST_F(ClientTest, testGetAccount) {
   auto resp = client.getAccount();
   EXPECT_OK(resp.first);
   auto account = resp.second;
-  EXPECT_EQ(account.status, "ACTIVE");
+  EXPECT_EQ(account.status, alpaca::AccountStatus::Active);
 }
 
 TEST_F(ClientTest, testGetAccountConfigurations) {
@@ -98,6 +98,38 @@ TEST_F(ClientTest, testOrders) {
   }
 }
 
+TEST_F(ClientTest, testSubmitOrders) {
+  auto client = alpaca::testClient();
+
+  // cancel any existing orders
+  auto cancel_orders_response = client.cancelOrders();
+  EXPECT_OK(cancel_orders_response.first);
+
+  // submit limit orders far below the market so that none of them fill
+  std::vector<alpaca::OrderRequest> requests;
+  for (const auto& symbol : {"AAPL", "GOOG", "NFLX", "AMZN", "MSFT", "SPY"}) {
+    auto request = alpaca::OrderRequest();
+    request.symbol = symbol;
+    request.quantity = 1;
+    request.type = alpaca::OrderType::Limit;
+    request.limit_price = alpaca::Decimal("1");
+    request.client_order_id = alpaca::randomString(16);
+    requests.push_back(request);
+  }
+  auto results = client.submitOrders(requests);
+
+  // validate that every result belongs to the request at the same position
+  ASSERT_EQ(results.size(), requests.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_OK(results[i].first);
+    EXPECT_EQ(results[i].second.symbol, requests[i].symbol);
+    EXPECT_EQ(results[i].second.client_order_id, requests[i].client_order_id);
+
+    auto cancel_order_response = client.cancelOrder(results[i].second.id);
+    EXPECT_OK(cancel_order_response.first);
+  }
+}
+
 TEST_F(ClientTest, testPositions) {
   auto client = alpaca::testClient();
   auto symbol = "NFLX";
@@ -181,8 +213,8 @@ TEST_F(ClientTest, testClock) {
   auto get_clock_response = client.getClock();
   EXPECT_OK(get_clock_response.first);
   auto clock = get_clock_response.second;
-  EXPECT_NE(clock.next_open, "");
-  EXPECT_NE(clock.next_close, "");
+  EXPECT_FALSE(clock.next_open.empty());
+  EXPECT_FALSE(clock.next_close.empty());
 }
 
 TEST_F(ClientTest, testCalendar) {
@@ -191,7 +223,7 @@ TEST_F(ClientTest, testCalendar) {
   EXPECT_OK(get_calendar_response.first);
   auto dates = get_calendar_response.second;
   for (const auto& date : dates) {
-    EXPECT_NE(date.date, "");
+    EXPECT_FALSE(date.date.empty());
     EXPECT_NE(date.open, "");
     EXPECT_NE(date.close, "");
   }
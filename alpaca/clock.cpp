@@ -1,24 +1,25 @@
 #include "alpaca/clock.h"
 
-#include "alpaca/json.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
 
 namespace alpaca {
-Status Clock::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing clock JSON");
-  }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a clock object");
-  }
+namespace {
+constexpr auto kClockSchema = makeSchema<Clock>("a clock",
+    {
+        {"is_open", &Clock::is_open},
+        {"next_close", &Clock::next_close},
+        {"next_open", &Clock::next_open},
+        {"timestamp", &Clock::timestamp},
+    });
+} // namespace
 
-  PARSE_BOOL(is_open, "is_open")
-  PARSE_STRING(next_close, "next_close")
-  PARSE_STRING(next_open, "next_open")
-  PARSE_STRING(timestamp, "timestamp")
+Status Clock::fromJSON(const std::string& json) {
+  return kClockSchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status Clock::fromDocument(const rapidjson::Value& d) {
+  return kClockSchema.read(d, *this);
 }
 } // namespace alpaca
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <string>
 
 #include "alpaca/status.h"
+#include "alpaca/timestamp.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
@@ -20,10 +22,20 @@ class Clock {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   bool is_open;
-  std::string next_close;
-  std::string next_open;
-  std::string timestamp;
+  Timestamp next_close;
+  Timestamp next_open;
+  Timestamp timestamp;
 };
 } // namespace alpaca
\ No newline at end of file
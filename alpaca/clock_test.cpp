@@ -18,7 +18,7 @@ TEST_F(ClockTest, testClockFromJSON) {
   alpaca::Clock clock;
   EXPECT_OK(clock.fromJSON(kClockJSON));
   EXPECT_TRUE(clock.is_open);
-  EXPECT_EQ(clock.timestamp, "2018-04-01T12:00:00.000Z");
-  EXPECT_EQ(clock.next_close, "2018-04-01T12:00:00.000Z");
-  EXPECT_EQ(clock.next_open, "2018-04-01T12:00:00.000Z");
+  EXPECT_EQ(clock.timestamp, alpaca::Timestamp("2018-04-01T12:00:00.000Z"));
+  EXPECT_EQ(clock.next_close, alpaca::Timestamp("2018-04-01T12:00:00.000Z"));
+  EXPECT_EQ(clock.next_open, alpaca::Timestamp("2018-04-01T12:00:00.000Z"));
 }
@@ -41,19 +41,19 @@ bool Environment::hasBeenParsed() const {
   return parsed_;
 }
 
-std::string Environment::getAPIKeyID() const {
+const std::string& Environment::getAPIKeyID() const {
   return api_key_id_;
 }
 
-std::string Environment::getAPISecretKey() const {
+const std::string& Environment::getAPISecretKey() const {
   return api_secret_key_;
 }
 
-std::string Environment::getAPIBaseURL() const {
+const std::string& Environment::getAPIBaseURL() const {
   return api_base_url_;
 }
 
-std::string Environment::getAPIDataURL() const {
+const std::string& Environment::getAPIDataURL() const {
   return api_data_url_;
 }
 } // namespace alpaca
\ No newline at end of file
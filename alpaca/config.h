@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include "alpaca/status.h"
@@ -62,7 +63,7 @@ class Environment {
    * Note that this method should only be called after successfully calliing
    * the parse() method.
    */
-  std::string getAPIKeyID() const;
+  const std::string& getAPIKeyID() const;
 
   /**
    * @brief A getter for the API Secret Key
@@ -70,7 +71,7 @@ class Environment {
    * Note that this method should only be called after successfully calliing
    * the parse() method.
    */
-  std::string getAPISecretKey() const;
+  const std::string& getAPISecretKey() const;
 
   /**
    * @brief A getter for the API Base URL
@@ -78,7 +79,7 @@ class Environment {
    * Note that this method should only be called after successfully calliing
    * the parse() method.
    */
-  std::string getAPIBaseURL() const;
+  const std::string& getAPIBaseURL() const;
 
   /**
    * @brief A getter for the API Data URL
@@ -86,7 +87,7 @@ class Environment {
    * Note that this method should only be called after successfully calliing
    * the parse() method.
    */
-  std::string getAPIDataURL() const;
+  const std::string& getAPIDataURL() const;
 
  private:
   bool parsed_;
@@ -101,4 +102,172 @@ class Environment {
   std::string api_base_url_env_var_;
   std::string api_data_url_env_var_;
 };
+
+/**
+ * @brief Controls how failed requests are retried.
+ *
+ * Requests are retried after a transport failure, an HTTP 429 or an HTTP 5xx.
+ * Only requests which are safe to repeat are retried: GET requests, and order
+ * submissions which carry a client_order_id.
+ */
+struct RetryPolicy {
+  /// The maximum number of attempts, including the first one. One disables
+  /// retries.
+  size_t max_attempts = 3;
+
+  /// The upper bound of the randomized delay before the first retry, which
+  /// doubles with every further retry
+  std::chrono::milliseconds initial_backoff = std::chrono::milliseconds(100);
+
+  /// The upper bound of the randomized delay before any retry
+  std::chrono::milliseconds max_backoff = std::chrono::milliseconds(5000);
+
+  /// Requests asked to wait longer than this by a Retry-After header fail
+  /// instead of being retried
+  std::chrono::milliseconds max_retry_after = std::chrono::milliseconds(30000);
+};
+
+/**
+ * @brief Controls hedging of latency-sensitive calls.
+ *
+ * When enabled, getOrder(), getPosition(), getLastQuote() and cancelOrder()
+ * send a second request over another pooled connection if the first one has
+ * not completed within the given percentile of recently observed latencies.
+ * Whichever request succeeds first is used.
+ */
+struct HedgingPolicy {
+  /// Whether latency-sensitive calls are hedged
+  bool enabled = false;
+
+  /// The percentile of recent latencies after which a hedge is sent
+  double percentile = 0.95;
+
+  /// The hedging delay used until enough latencies have been observed
+  std::chrono::milliseconds initial_delay = std::chrono::milliseconds(100);
+
+  /// Hedges are never sent sooner than this after the first request
+  std::chrono::milliseconds min_delay = std::chrono::milliseconds(5);
+
+  /// The number of threads which send hedges. The first request of a hedged
+  /// call is sent from the calling thread, and a hedge only takes a thread
+  /// once its delay has passed.
+  size_t threads = 8;
+};
+
+/**
+ * @brief Controls which classes of endpoints request compressed responses.
+ *
+ * Compression saves bandwidth on large responses at the cost of some CPU time
+ * to decompress them, so it is enabled by default only for the endpoints which
+ * return bulk data.
+ */
+struct CompressionPolicy {
+  /// Orders, positions and account endpoints
+  bool trading = false;
+
+  /// The account activity endpoint, which can return long histories
+  bool account_activity = true;
+
+  /// Reference data endpoints such as assets, calendar, clock and watchlists
+  bool reference_data = true;
+
+  /// Market data endpoints such as bars and last quotes
+  bool market_data = true;
+};
+
+/**
+ * @brief Controls how long responses from slowly changing endpoints are
+ * reused.
+ *
+ * A TTL of zero, the default, disables caching for that endpoint. Cached
+ * responses can be dropped early with Client::invalidateCache().
+ */
+struct CachePolicy {
+  /// getAssets() and getAsset()
+  std::chrono::milliseconds assets_ttl = std::chrono::milliseconds(0);
+
+  /// getCalendar()
+  std::chrono::milliseconds calendar_ttl = std::chrono::milliseconds(0);
+
+  /// getClock()
+  std::chrono::milliseconds clock_ttl = std::chrono::milliseconds(0);
+
+  /// getWatchlists()
+  std::chrono::milliseconds watchlists_ttl = std::chrono::milliseconds(0);
+};
+
+/**
+ * @brief Controls the on-disk snapshot of reference data which lets a client
+ * start without waiting for the API.
+ *
+ * When a path is set, the client serves getAssets() and getCalendar() from the
+ * snapshot at that path as soon as it is constructed, as long as the snapshot
+ * is younger than max_age, and refreshes the snapshot in the background.
+ */
+struct SnapshotPolicy {
+  /// The snapshot file; an empty path disables snapshots
+  std::string path;
+
+  /// How long after it was taken a snapshot is served
+  std::chrono::seconds max_age = std::chrono::hours(12);
+
+  /// The range of the calendar which is snapshotted, as YYYY-MM-DD; the
+  /// calendar is not snapshotted if either is empty
+  std::string calendar_start;
+  std::string calendar_end;
+};
+
+/**
+ * @brief Tunable options which control how an alpaca::Client talks to the API.
+ *
+ * @code{.cpp}
+ *   auto options = alpaca::ClientOptions();
+ *   options.connection_pool_size = 8;
+ *   auto client = alpaca::Client(env, options);
+ * @endcode
+ */
+struct ClientOptions {
+  /// The maximum number of idle connections kept open to each API host
+  size_t connection_pool_size = 4;
+
+  /// Idle connections older than this are discarded instead of being reused
+  std::chrono::seconds connection_idle_timeout = std::chrono::seconds(30);
+
+  /// The number of connections to the trading API host which are opened in
+  /// the background when the client is constructed and kept warm afterwards
+  size_t warm_connections = 0;
+
+  /// How often warm connections are exercised so that the server does not
+  /// close them, or zero to disable the heartbeat
+  std::chrono::seconds keep_warm_interval = std::chrono::seconds(0);
+
+  /// The number of threads which run asynchronous calls
+  size_t io_threads = 4;
+
+  /// The maximum number of orders submitOrders() keeps in flight at once,
+  /// which is capped at connection_pool_size
+  size_t order_concurrency = 16;
+
+  /// The request budget per minute shared by every endpoint, or zero to
+  /// disable client-side rate limiting
+  size_t rate_limit_per_minute = 200;
+
+  /// Whether concurrent identical GET requests share a single request
+  bool coalesce_requests = true;
+
+  /// How failed requests are retried
+  RetryPolicy retry_policy;
+
+  /// How latency-sensitive calls are hedged
+  HedgingPolicy hedging_policy;
+
+  /// Which endpoints request gzip or deflate compressed responses
+  CompressionPolicy compression_policy;
+
+  /// How long responses from slowly changing endpoints are cached
+  CachePolicy cache_policy;
+
+  /// Where and for how long reference data is persisted between runs
+  SnapshotPolicy snapshot_policy;
+};
 } // namespace alpaca
\ No newline at end of file
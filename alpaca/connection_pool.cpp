@@ -0,0 +1,186 @@
+#include "alpaca/connection_pool.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace alpaca {
+
+namespace detail {
+bool PooledClient::isSocketAlive() const {
+  std::lock_guard<std::mutex> lock(socket_mutex_);
+  if (!socket_.is_open()) {
+    return true;
+  }
+
+  pollfd fd = {socket_.sock, POLLIN, 0};
+  auto ready = ::poll(&fd, 1, 0);
+  if (ready == 0) {
+    return true;
+  }
+  if (ready < 0 || (fd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+    return false;
+  }
+  // Readable means EOF, an error or bytes which no request asked for. Peeking
+  // tells a spurious wakeup apart without consuming anything.
+  char byte;
+  auto received = ::recv(socket_.sock, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+  return received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+} // namespace detail
+
+ConnectionPool::ConnectionPool(std::string host, const ClientOptions& options, TLSSessionCache* sessions)
+    : host_(std::move(host)),
+      size_(options.connection_pool_size),
+      idle_timeout_(options.connection_idle_timeout),
+      sessions_(sessions) {
+  idle_.reserve(size_);
+}
+
+std::shared_ptr<httplib::Response> ConnectionPool::Get(const char* path, const httplib::Headers& headers) {
+  return execute([&](httplib::SSLClient& client) { return client.Get(path, headers); });
+}
+
+std::shared_ptr<httplib::Response> ConnectionPool::Get(const char* path,
+                                                       const httplib::Headers& headers,
+                                                       httplib::ResponseHandler response_handler,
+                                                       httplib::ContentReceiver content_receiver) {
+  return execute(
+      [&](httplib::SSLClient& client) { return client.Get(path, headers, response_handler, content_receiver); });
+}
+
+std::shared_ptr<httplib::Response> ConnectionPool::Post(const char* path,
+                                                        const httplib::Headers& headers,
+                                                        const std::string& body,
+                                                        const char* content_type) {
+  return execute([&](httplib::SSLClient& client) { return client.Post(path, headers, body, content_type); });
+}
+
+std::shared_ptr<httplib::Response> ConnectionPool::Put(const char* path,
+                                                       const httplib::Headers& headers,
+                                                       const std::string& body,
+                                                       const char* content_type) {
+  return execute([&](httplib::SSLClient& client) { return client.Put(path, headers, body, content_type); });
+}
+
+std::shared_ptr<httplib::Response> ConnectionPool::Patch(const char* path,
+                                                         const httplib::Headers& headers,
+                                                         const std::string& body,
+                                                         const char* content_type) {
+  return execute([&](httplib::SSLClient& client) { return client.Patch(path, headers, body, content_type); });
+}
+
+std::shared_ptr<httplib::Response> ConnectionPool::Delete(const char* path, const httplib::Headers& headers) {
+  return execute([&](httplib::SSLClient& client) { return client.Delete(path, headers); });
+}
+
+size_t ConnectionPool::warm(
+    Executor& executor,
+    size_t connections,
+    const std::function<std::shared_ptr<httplib::Response>(httplib::SSLClient&)>& request) {
+  connections = std::min(connections, size_);
+  std::vector<Connection> checked_out;
+  checked_out.reserve(connections);
+  for (size_t i = 0; i < connections; ++i) {
+    checked_out.push_back(acquire());
+  }
+
+  std::atomic<size_t> warmed{0};
+  parallelFor(executor, connections, connections, [&](size_t i) {
+    if (request(*checked_out[i].client)) {
+      ++warmed;
+    } else {
+      checked_out[i].client.reset();
+    }
+  });
+
+  for (auto& connection : checked_out) {
+    if (connection.client) {
+      release(std::move(connection));
+    }
+  }
+  DLOG(INFO) << "Warmed " << warmed << " of " << connections << " connections to " << host_;
+  return warmed;
+}
+
+const std::string& ConnectionPool::getHost() const {
+  return host_;
+}
+
+size_t ConnectionPool::idleConnections() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_.size();
+}
+
+void ConnectionPool::clear() {
+  std::vector<Connection> discarded;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    discarded.swap(idle_);
+  }
+}
+
+ConnectionPool::Connection ConnectionPool::acquire() {
+  std::vector<Connection> expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    // The most recently used connection sits at the back of the idle list and
+    // is the one least likely to have been closed by the server.
+    while (!idle_.empty()) {
+      auto connection = std::move(idle_.back());
+      idle_.pop_back();
+      if (now - connection.last_used < idle_timeout_ && connection.client->is_valid() &&
+          connection.client->isSocketAlive()) {
+        return connection;
+      }
+      expired.push_back(std::move(connection));
+    }
+  }
+
+  if (!expired.empty()) {
+    DLOG(INFO) << "Discarding " << expired.size() << " expired or closed connections to " << host_;
+  }
+
+  Connection connection;
+  connection.client = std::make_unique<detail::PooledClient>(host_);
+  connection.client->set_keep_alive(true);
+  // Responses are only compressed when the request asks for it through its
+  // Accept-Encoding header, so decompression can always be left on.
+  connection.client->set_decompress(true);
+  if (sessions_ != nullptr) {
+    sessions_->install(connection.client->ssl_context());
+  }
+  return connection;
+}
+
+void ConnectionPool::release(Connection connection) {
+  connection.last_used = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (idle_.size() < size_) {
+    idle_.push_back(std::move(connection));
+    return;
+  }
+  DLOG(INFO) << "Connection pool for " << host_ << " is full, closing connection";
+}
+
+std::shared_ptr<httplib::Response> ConnectionPool::execute(
+    const std::function<std::shared_ptr<httplib::Response>(httplib::SSLClient&)>& request) {
+  auto connection = acquire();
+  auto resp = request(*connection.client);
+  if (!resp) {
+    DLOG(INFO) << "Discarding connection to " << host_ << " after a failed request";
+    return resp;
+  }
+
+  release(std::move(connection));
+  return resp;
+}
+} // namespace alpaca
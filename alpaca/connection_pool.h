@@ -0,0 +1,181 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "alpaca/config.h"
+#include "alpaca/executor.h"
+#include "alpaca/http.h"
+#include "alpaca/tls_session_cache.h"
+
+namespace alpaca {
+
+namespace detail {
+/**
+ * @brief An SSLClient which can check the socket it keeps alive between
+ * requests.
+ */
+class PooledClient : public httplib::SSLClient {
+ public:
+  using httplib::SSLClient::SSLClient;
+
+  /**
+   * @brief Whether the kept-alive socket can carry another request.
+   *
+   * An idle HTTP/1.1 connection has nothing to read, so a socket which has
+   * hung up, has a pending error or has unread bytes (such as a TLS
+   * close_notify alert) was closed by the server or is out of step with it.
+   * A client with no open socket is usable, since it connects on its next
+   * request.
+   */
+  bool isSocketAlive() const;
+};
+} // namespace detail
+
+/**
+ * @brief A pool of kept-alive HTTPS connections to a single API host.
+ *
+ * Connections are checked out for the duration of a single request and
+ * returned afterwards, so the TCP connection and TLS session established by
+ * one call are reused by the next one instead of being torn down.
+ *
+ * @code{.cpp}
+ *   auto pool = alpaca::ConnectionPool(env.getAPIBaseURL(), options);
+ *   auto resp = pool.Get("/v2/clock", headers);
+ * @endcode
+ */
+class ConnectionPool {
+ public:
+  /**
+   * @brief The primary constructor.
+   *
+   * @param host The host which all connections in the pool connect to.
+   * @param options The client options which configure pool size and expiry.
+   * @param sessions If set, new connections resume TLS sessions from this
+   * cache. The cache must outlive the pool.
+   */
+  ConnectionPool(std::string host, const ClientOptions& options, TLSSessionCache* sessions = nullptr);
+
+  /**
+   * @brief The default constructor of ConnectionPool should never be used.
+   */
+  explicit ConnectionPool() = delete;
+
+  ConnectionPool(const ConnectionPool&) = delete;
+  ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+  /**
+   * @brief Issue a GET request over a pooled connection.
+   */
+  std::shared_ptr<httplib::Response> Get(const char* path, const httplib::Headers& headers);
+
+  /**
+   * @brief Issue a GET request over a pooled connection, passing the body to
+   * content_receiver in chunks as it arrives instead of buffering it.
+   */
+  std::shared_ptr<httplib::Response> Get(const char* path,
+                                         const httplib::Headers& headers,
+                                         httplib::ResponseHandler response_handler,
+                                         httplib::ContentReceiver content_receiver);
+
+  /**
+   * @brief Issue a POST request over a pooled connection.
+   */
+  std::shared_ptr<httplib::Response> Post(const char* path,
+                                          const httplib::Headers& headers,
+                                          const std::string& body,
+                                          const char* content_type);
+
+  /**
+   * @brief Issue a PUT request over a pooled connection.
+   */
+  std::shared_ptr<httplib::Response> Put(const char* path,
+                                         const httplib::Headers& headers,
+                                         const std::string& body,
+                                         const char* content_type);
+
+  /**
+   * @brief Issue a PATCH request over a pooled connection.
+   */
+  std::shared_ptr<httplib::Response> Patch(const char* path,
+                                           const httplib::Headers& headers,
+                                           const std::string& body,
+                                           const char* content_type);
+
+  /**
+   * @brief Issue a DELETE request over a pooled connection.
+   */
+  std::shared_ptr<httplib::Response> Delete(const char* path, const httplib::Headers& headers);
+
+  /**
+   * @brief Run a request on a pooled connection.
+   *
+   * Connections whose request failed at the transport level are discarded
+   * rather than returned so that a broken socket is never handed out again.
+   */
+  std::shared_ptr<httplib::Response> execute(
+      const std::function<std::shared_ptr<httplib::Response>(httplib::SSLClient&)>& request);
+
+  /**
+   * @brief Open connections ahead of time and keep idle ones from going stale.
+   *
+   * Checks out the given number of connections at once (reusing idle ones and
+   * opening new ones as needed), runs the request on each of them in parallel
+   * on the executor and returns the healthy ones to the pool. Running a cheap
+   * request is what completes the TLS handshake and resets the server's idle
+   * timer.
+   *
+   * @return the number of connections which completed the request.
+   */
+  size_t warm(Executor& executor,
+              size_t connections,
+              const std::function<std::shared_ptr<httplib::Response>(httplib::SSLClient&)>& request);
+
+  /**
+   * @brief The host that this pool connects to.
+   */
+  const std::string& getHost() const;
+
+  /**
+   * @brief The number of connections currently idle in the pool.
+   */
+  size_t idleConnections() const;
+
+  /**
+   * @brief Close and discard every idle connection in the pool.
+   */
+  void clear();
+
+ private:
+  /**
+   * @brief A connection along with the last time it was used.
+   */
+  struct Connection {
+    std::unique_ptr<detail::PooledClient> client;
+    std::chrono::steady_clock::time_point last_used;
+  };
+
+  /**
+   * @brief Check out a healthy connection, creating one if none are idle.
+   */
+  Connection acquire();
+
+  /**
+   * @brief Return a connection to the pool after a successful request.
+   */
+  void release(Connection connection);
+
+ private:
+  std::string host_;
+  size_t size_;
+  std::chrono::seconds idle_timeout_;
+  TLSSessionCache* sessions_;
+
+  mutable std::mutex mutex_;
+  std::vector<Connection> idle_;
+};
+} // namespace alpaca
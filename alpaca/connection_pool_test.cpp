@@ -0,0 +1,102 @@
+#include "alpaca/connection_pool.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class ConnectionPoolTest : public ::testing::Test {};
+
+namespace {
+/**
+ * @brief A PooledClient whose kept-alive socket is one end of a socket pair.
+ */
+class SocketPairClient : public alpaca::detail::PooledClient {
+ public:
+  SocketPairClient() : PooledClient("localhost.invalid") {
+    ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds_);
+    socket_.sock = fds_[0];
+  }
+
+  ~SocketPairClient() {
+    socket_.sock = INVALID_SOCKET;
+    ::close(fds_[0]);
+    closePeer();
+  }
+
+  void closePeer() {
+    if (fds_[1] != -1) {
+      ::close(fds_[1]);
+      fds_[1] = -1;
+    }
+  }
+
+  void sendFromPeer(const std::string& data) {
+    EXPECT_EQ(::send(fds_[1], data.data(), data.size(), 0), data.size());
+  }
+
+ private:
+  int fds_[2] = {-1, -1};
+};
+} // namespace
+
+TEST_F(ConnectionPoolTest, testConstructor) {
+  auto options = alpaca::ClientOptions();
+  alpaca::ConnectionPool pool("paper-api.alpaca.markets", options);
+  EXPECT_EQ(pool.getHost(), "paper-api.alpaca.markets");
+  EXPECT_EQ(pool.idleConnections(), 0);
+}
+
+TEST_F(ConnectionPoolTest, testFailedRequestDiscardsConnection) {
+  auto options = alpaca::ClientOptions();
+  alpaca::ConnectionPool pool("localhost.invalid", options);
+
+  auto resp = pool.execute([](httplib::SSLClient&) { return std::make_shared<httplib::Response>(); });
+  EXPECT_NE(resp, nullptr);
+  EXPECT_EQ(pool.idleConnections(), 1);
+
+  resp = pool.execute([](httplib::SSLClient&) { return std::shared_ptr<httplib::Response>(); });
+  EXPECT_EQ(resp, nullptr);
+  EXPECT_EQ(pool.idleConnections(), 0);
+}
+
+TEST_F(ConnectionPoolTest, testWarmKeepsHealthyConnections) {
+  auto options = alpaca::ClientOptions();
+  options.connection_pool_size = 2;
+  alpaca::ConnectionPool pool("localhost.invalid", options);
+
+  alpaca::Executor executor(2);
+  std::atomic<int> calls{0};
+  auto warmed = pool.warm(executor, 3, [&calls](httplib::SSLClient&) {
+    ++calls;
+    return std::make_shared<httplib::Response>();
+  });
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(warmed, 2);
+  EXPECT_EQ(pool.idleConnections(), 2);
+
+  warmed = pool.warm(executor, 2, [](httplib::SSLClient&) { return std::shared_ptr<httplib::Response>(); });
+  EXPECT_EQ(warmed, 0);
+  EXPECT_EQ(pool.idleConnections(), 0);
+}
+
+TEST_F(ConnectionPoolTest, testSocketLiveness) {
+  EXPECT_TRUE(alpaca::detail::PooledClient("localhost.invalid").isSocketAlive());
+
+  SocketPairClient idle;
+  EXPECT_TRUE(idle.isSocketAlive());
+
+  SocketPairClient closed;
+  closed.closePeer();
+  EXPECT_FALSE(closed.isSocketAlive());
+
+  SocketPairClient unread;
+  unread.sendFromPeer("HTTP/1.1 408 Request Timeout\r\n\r\n");
+  EXPECT_FALSE(unread.isSocketAlive());
+  // The probe only peeks, so the bytes are still there to read.
+  EXPECT_FALSE(unread.isSocketAlive());
+}
@@ -0,0 +1,567 @@
+#pragma once
+
+/**
+ * @brief C++20 coroutine support for the Alpaca client.
+ *
+ * The library itself is built as C++17, so everything in this header is only
+ * available to translation units compiled with coroutine support (for example
+ * with -std=c++20). It is header-only for the same reason.
+ *
+ * Strategy code is written as alpaca::coro::Task coroutines which are driven
+ * by a single alpaca::coro::EventLoop thread. Network I/O runs on the client's
+ * I/O threads and the awaiting coroutine is resumed on the event loop when the
+ * response arrives, so many coroutines can share one thread.
+ *
+ * The I/O itself is still blocking: every awaited call occupies one of the
+ * client's I/O threads until its response arrives. At most
+ * ClientOptions::io_threads calls are in flight at once, and further awaits
+ * queue behind them, so size io_threads for the concurrency the strategy
+ * needs. Stream messages are awaited through a StreamSource.
+ *
+ * @code{.cpp}
+ *   alpaca::coro::Task<> strategy(alpaca::coro::EventLoop& loop, alpaca::Client& client) {
+ *     auto [status, account] = co_await alpaca::coro::call(
+ *         loop, [&](auto callback) { return client.getAccountAsync(callback); });
+ *     if (!status.ok()) {
+ *       LOG(ERROR) << "Error getting account information: " << status.getMessage();
+ *       co_return;
+ *     }
+ *     LOG(INFO) << "ID: " << account.id;
+ *   }
+ *
+ *   auto loop = alpaca::coro::EventLoop();
+ *   loop.spawn(strategy(loop, client));
+ *   loop.run();
+ * @endcode
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "alpaca/config.h"
+#include "alpaca/status.h"
+#include "alpaca/streaming.h"
+#include "glog/logging.h"
+
+namespace alpaca::coro {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Resumes the awaiting coroutine, if any, when a Task finishes.
+ */
+struct FinalAwaiter {
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+    if (auto continuation = handle.promise().continuation) {
+      return continuation;
+    }
+    return std::noop_coroutine();
+  }
+
+  void await_resume() noexcept {}
+};
+
+/**
+ * @brief The state shared by the promises of every Task.
+ */
+struct PromiseBase {
+  std::coroutine_handle<> continuation;
+  std::exception_ptr exception;
+
+  std::suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  FinalAwaiter final_suspend() noexcept {
+    return {};
+  }
+
+  void unhandled_exception() noexcept {
+    exception = std::current_exception();
+  }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+  std::optional<T> value;
+
+  Task<T> get_return_object() noexcept;
+
+  template <typename U>
+  void return_value(U&& v) {
+    value.emplace(std::forward<U>(v));
+  }
+
+  T result() {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    return std::move(*value);
+  }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+  Task<void> get_return_object() noexcept;
+
+  void return_void() noexcept {}
+
+  void result() {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+};
+
+/**
+ * @brief A fire-and-forget coroutine used to run spawned tasks.
+ */
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() noexcept {
+      return Detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+
+    void return_void() noexcept {}
+
+    void unhandled_exception() noexcept {
+      std::terminate();
+    }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Extracts T from the std::future<T> returned by an asynchronous call.
+ */
+template <typename F>
+struct FutureValue;
+
+template <typename T>
+struct FutureValue<std::future<T>> {
+  using type = T;
+};
+
+/**
+ * @brief A stand-in callback used to deduce the result type of a call.
+ */
+struct AnyCallback {
+  template <typename T>
+  void operator()(const T&) const {}
+};
+} // namespace detail
+
+/**
+ * @brief A lazily started coroutine which produces a value of type T.
+ *
+ * A Task does not run until it is awaited or spawned on an EventLoop.
+ */
+template <typename T>
+class Task {
+ public:
+  using promise_type = detail::Promise<T>;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept {
+    return !handle_ || handle_.done();
+  }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    handle_.promise().continuation = awaiting;
+    return handle_;
+  }
+
+  T await_resume() {
+    return handle_.promise().result();
+  }
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+  return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+} // namespace detail
+
+/**
+ * @brief A single-threaded loop which resumes coroutines.
+ *
+ * Coroutines are only ever resumed on the thread which calls run(), so state
+ * shared between tasks on the same loop needs no synchronization.
+ */
+class EventLoop {
+ public:
+  EventLoop() = default;
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  /**
+   * @brief Schedule a suspended coroutine to be resumed on the loop.
+   *
+   * This method is thread-safe and is how I/O threads hand completed calls
+   * back to the loop.
+   */
+  void post(std::coroutine_handle<> handle) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready_.push_back(handle);
+    }
+    cv_.notify_one();
+  }
+
+  /**
+   * @brief Start a top-level task on the loop.
+   *
+   * Exceptions which escape a spawned task are logged and otherwise ignored.
+   */
+  void spawn(Task<> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++outstanding_;
+    }
+    post(detach(this, std::move(task)).handle);
+  }
+
+  /**
+   * @brief Resume coroutines until every spawned task has completed.
+   */
+  void run() {
+    while (true) {
+      std::coroutine_handle<> handle;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !ready_.empty() || outstanding_ == 0; });
+        if (ready_.empty()) {
+          return;
+        }
+        handle = ready_.front();
+        ready_.pop_front();
+      }
+      handle.resume();
+    }
+  }
+
+ private:
+  static detail::Detached detach(EventLoop* loop, Task<> task) {
+    try {
+      co_await std::move(task);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Uncaught exception in spawned task: " << e.what();
+    } catch (...) {
+      LOG(ERROR) << "Uncaught exception in spawned task";
+    }
+    loop->finished();
+  }
+
+  void finished() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --outstanding_;
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::coroutine_handle<>> ready_;
+  size_t outstanding_ = 0;
+};
+
+/**
+ * @brief An awaitable which starts an asynchronous Client call.
+ *
+ * @see call()
+ */
+template <typename Starter>
+class CallAwaiter {
+ public:
+  using Result =
+      typename detail::FutureValue<std::invoke_result_t<Starter&, detail::AnyCallback>>::type;
+
+  CallAwaiter(EventLoop& loop, Starter starter) : loop_(loop), starter_(std::move(starter)) {}
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    starter_([this, handle](const Result& result) {
+      result_.emplace(result);
+      loop_.post(handle);
+    });
+  }
+
+  Result await_resume() {
+    return std::move(*result_);
+  }
+
+ private:
+  EventLoop& loop_;
+  Starter starter_;
+  std::optional<Result> result_;
+};
+
+/**
+ * @brief Await an asynchronous Client call from a coroutine.
+ *
+ * The starter is invoked with a callback and must pass it to one of the
+ * Client's *Async methods, returning the resulting std::future. The awaiting
+ * coroutine is resumed on the loop once the call completes.
+ *
+ * @code{.cpp}
+ *   auto [status, clock] = co_await alpaca::coro::call(
+ *       loop, [&](auto callback) { return client.getClockAsync(callback); });
+ * @endcode
+ */
+template <typename Starter>
+CallAwaiter<Starter> call(EventLoop& loop, Starter starter) {
+  return CallAwaiter<Starter>(loop, std::move(starter));
+}
+
+/**
+ * @brief A thread-safe queue which coroutines can await values from.
+ *
+ * Values may be pushed from any thread; waiting coroutines are resumed on the
+ * loop.
+ *
+ * @code{.cpp}
+ *   auto prices = alpaca::coro::Channel<double>(loop);
+ *   auto feed_thread = std::thread([&]() { prices.push(readPrice()); prices.close(); });
+ *
+ *   // inside a coroutine running on the loop
+ *   while (auto price = co_await prices.next()) {
+ *     LOG(INFO) << "Price: " << *price;
+ *   }
+ * @endcode
+ */
+template <typename T>
+class Channel {
+ public:
+  explicit Channel(EventLoop& loop) : loop_(loop) {}
+  Channel(const Channel&) = delete;
+  Channel& operator=(const Channel&) = delete;
+
+  /**
+   * @brief Deliver a value to the next waiting coroutine, or queue it.
+   */
+  void push(T value) {
+    std::coroutine_handle<> handle;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_) {
+        return;
+      }
+      if (waiters_.empty()) {
+        values_.push_back(std::move(value));
+        return;
+      }
+      auto waiter = waiters_.front();
+      waiters_.pop_front();
+      waiter.first->emplace(std::move(value));
+      handle = waiter.second;
+    }
+    loop_.post(handle);
+  }
+
+  /**
+   * @brief Close the channel, waking every waiting coroutine with no value.
+   */
+  void close() {
+    std::deque<std::pair<std::optional<T>*, std::coroutine_handle<>>> waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      waiters.swap(waiters_);
+    }
+    for (auto& waiter : waiters) {
+      loop_.post(waiter.second);
+    }
+  }
+
+  /**
+   * @brief An awaitable which resolves to the next value in the channel.
+   */
+  class NextAwaiter {
+   public:
+    explicit NextAwaiter(Channel& channel) : channel_(channel) {}
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      std::lock_guard<std::mutex> lock(channel_.mutex_);
+      if (!channel_.values_.empty()) {
+        value_.emplace(std::move(channel_.values_.front()));
+        channel_.values_.pop_front();
+        return false;
+      }
+      if (channel_.closed_) {
+        return false;
+      }
+      channel_.waiters_.emplace_back(&value_, handle);
+      return true;
+    }
+
+    std::optional<T> await_resume() {
+      return std::move(value_);
+    }
+
+   private:
+    Channel& channel_;
+    std::optional<T> value_;
+  };
+
+  /**
+   * @brief Wait for the next value, or std::nullopt once the channel is closed.
+   */
+  NextAwaiter next() {
+    return NextAwaiter(*this);
+  }
+
+ private:
+  EventLoop& loop_;
+  std::mutex mutex_;
+  std::deque<T> values_;
+  std::deque<std::pair<std::optional<T>*, std::coroutine_handle<>>> waiters_;
+  bool closed_ = false;
+};
+
+/**
+ * @brief Trade and account updates from the Alpaca stream, which coroutines
+ * await one at a time.
+ *
+ * run() connects an alpaca::stream::Handler and blocks the thread which calls
+ * it, pushing every update into a Channel. Coroutines await them with next()
+ * and are resumed on the loop, so they never block on the stream. Once run()
+ * returns, waiting coroutines wake with std::nullopt.
+ *
+ * @code{.cpp}
+ *   auto updates = alpaca::coro::StreamSource(loop);
+ *   auto stream_thread = std::thread([&]() { updates.run(env); });
+ *
+ *   // inside a coroutine running on the loop
+ *   while (auto update = co_await updates.next()) {
+ *     if (update->type == alpaca::stream::TradeUpdates) {
+ *       LOG(INFO) << "Trade update: " << update->data;
+ *     }
+ *   }
+ * @endcode
+ */
+class StreamSource {
+ public:
+  /**
+   * @brief An update, along with the stream which it came from.
+   */
+  struct Message {
+    stream::StreamType type = stream::UnknownStreamType;
+    stream::DataType data;
+  };
+
+  explicit StreamSource(EventLoop& loop)
+      : messages_(loop),
+        handler_([this](stream::DataType data) { push(stream::TradeUpdates, std::move(data)); },
+                 [this](stream::DataType data) { push(stream::AccountUpdates, std::move(data)); }) {}
+
+  StreamSource(const StreamSource&) = delete;
+  StreamSource& operator=(const StreamSource&) = delete;
+
+  /**
+   * @brief Connect to the stream and deliver its updates, blocking until the
+   * stream handler returns.
+   */
+  Status run(Environment& env) {
+    auto status = handler_.run(env);
+    close();
+    return status;
+  }
+
+  /**
+   * @brief Deliver an update to the next waiting coroutine, or queue it.
+   *
+   * run() calls this for every update, and it may also be called from any
+   * other thread.
+   */
+  void push(const stream::StreamType type, stream::DataType data) {
+    messages_.push(Message{type, std::move(data)});
+  }
+
+  /**
+   * @brief Stop delivering updates, waking every waiting coroutine with no
+   * message.
+   */
+  void close() {
+    messages_.close();
+  }
+
+  /**
+   * @brief Wait for the next update, or std::nullopt once the source is
+   * closed.
+   */
+  Channel<Message>::NextAwaiter next() {
+    return messages_.next();
+  }
+
+ private:
+  Channel<Message> messages_;
+  stream::Handler handler_;
+};
+} // namespace alpaca::coro
+
+#endif
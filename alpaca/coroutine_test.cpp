@@ -0,0 +1,115 @@
+#include "alpaca/coroutine.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "alpaca/executor.h"
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class CoroutineTest : public ::testing::Test {};
+
+alpaca::coro::Task<int> add(int a, int b) {
+  co_return a + b;
+}
+
+TEST_F(CoroutineTest, testNestedTasks) {
+  auto loop = alpaca::coro::EventLoop();
+  auto result = 0;
+  loop.spawn([](int& result) -> alpaca::coro::Task<> {
+    auto a = co_await add(1, 2);
+    auto b = co_await add(a, 3);
+    result = b;
+  }(result));
+  loop.run();
+  EXPECT_EQ(result, 6);
+}
+
+TEST_F(CoroutineTest, testCallResumesOnLoop) {
+  auto loop = alpaca::coro::EventLoop();
+  auto executor = alpaca::Executor(4);
+  auto loop_thread = std::this_thread::get_id();
+
+  // Stands in for a Client *Async method: runs on an I/O thread, invokes the
+  // callback and returns a future for the same result.
+  auto fetch = [&executor](int value, alpaca::Callback<int> callback) {
+    return executor.submit([value, callback]() {
+      auto result = std::make_pair(alpaca::Status(), value * 2);
+      callback(result);
+      return result;
+    });
+  };
+
+  std::vector<int> results;
+  for (int i = 0; i < 100; ++i) {
+    loop.spawn([](alpaca::coro::EventLoop& loop,
+                  auto fetch,
+                  int i,
+                  std::vector<int>& results,
+                  std::thread::id loop_thread) -> alpaca::coro::Task<> {
+      auto [status, value] = co_await alpaca::coro::call(loop, [&](auto callback) { return fetch(i, callback); });
+      EXPECT_OK(status);
+      EXPECT_EQ(std::this_thread::get_id(), loop_thread);
+      results.push_back(value);
+    }(loop, fetch, i, results, loop_thread));
+  }
+  loop.run();
+  EXPECT_EQ(results.size(), 100);
+}
+
+TEST_F(CoroutineTest, testChannel) {
+  auto loop = alpaca::coro::EventLoop();
+  auto channel = alpaca::coro::Channel<std::string>(loop);
+
+  std::vector<std::string> received;
+  loop.spawn([](alpaca::coro::Channel<std::string>& channel, std::vector<std::string>& received)
+                 -> alpaca::coro::Task<> {
+    while (auto message = co_await channel.next()) {
+      received.push_back(*message);
+    }
+  }(channel, received));
+
+  auto producer = std::thread([&channel]() {
+    for (int i = 0; i < 10; ++i) {
+      channel.push(std::to_string(i));
+    }
+    channel.close();
+  });
+  loop.run();
+  producer.join();
+
+  ASSERT_EQ(received.size(), 10);
+  EXPECT_EQ(received.front(), "0");
+  EXPECT_EQ(received.back(), "9");
+}
+
+TEST_F(CoroutineTest, testStreamSource) {
+  auto loop = alpaca::coro::EventLoop();
+  auto updates = alpaca::coro::StreamSource(loop);
+
+  std::vector<std::pair<alpaca::stream::StreamType, std::string>> received;
+  loop.spawn([](alpaca::coro::StreamSource& updates,
+                std::vector<std::pair<alpaca::stream::StreamType, std::string>>& received) -> alpaca::coro::Task<> {
+    while (auto update = co_await updates.next()) {
+      received.emplace_back(update->type, update->data);
+    }
+  }(updates, received));
+
+  auto stream_thread = std::thread([&updates]() {
+    updates.push(alpaca::stream::TradeUpdates, "{\"event\":\"fill\"}");
+    updates.push(alpaca::stream::AccountUpdates, "{\"status\":\"ACTIVE\"}");
+    updates.close();
+  });
+  loop.run();
+  stream_thread.join();
+
+  ASSERT_EQ(received.size(), 2);
+  EXPECT_EQ(received[0], std::make_pair(alpaca::stream::TradeUpdates, std::string("{\"event\":\"fill\"}")));
+  EXPECT_EQ(received[1].first, alpaca::stream::AccountUpdates);
+}
+
+#endif
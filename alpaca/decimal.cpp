@@ -0,0 +1,276 @@
+#include "alpaca/decimal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace alpaca {
+
+namespace {
+/// Wide enough for the product of two mantissas, or a mantissa scaled by
+/// 10^kMaxScale
+using Wide = __int128;
+
+constexpr Wide kMaxMantissa = INT64_MAX;
+constexpr Wide kMinMantissa = INT64_MIN;
+
+constexpr int64_t kPowersOfTen[Decimal::kMaxScale + 1] = {
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000,
+    100000000000,
+    1000000000000,
+    10000000000000,
+    100000000000000,
+    1000000000000000,
+    10000000000000000,
+    100000000000000000,
+    1000000000000000000,
+};
+
+/**
+ * @brief 10^exponent, for exponents up to twice kMaxScale.
+ */
+Wide powerOfTen(const int exponent) {
+  Wide power = 1;
+  for (auto i = 0; i < exponent; ++i) {
+    power *= 10;
+  }
+  return power;
+}
+
+/**
+ * @brief Divide by a power of ten, rounding half away from zero.
+ */
+Wide divideRounded(const Wide value, const Wide divisor) {
+  auto quotient = value / divisor;
+  auto remainder = value % divisor;
+  if (remainder * 2 >= divisor) {
+    ++quotient;
+  } else if (remainder * 2 <= -divisor) {
+    --quotient;
+  }
+  return quotient;
+}
+
+bool fits(const Wide mantissa) {
+  return mantissa >= kMinMantissa && mantissa <= kMaxMantissa;
+}
+
+/**
+ * @brief Drop fractional digits until the value fits in a Decimal, saturating
+ * if it doesn't fit with none.
+ *
+ * The digits are dropped at once and the result is rounded a single time, so
+ * that rounding one digit doesn't carry into the next.
+ */
+Decimal normalize(Wide mantissa, int scale) {
+  auto drop = std::max(scale - Decimal::kMaxScale, 0);
+  if (drop > 0 || !fits(mantissa)) {
+    while (drop < scale && !fits(mantissa / powerOfTen(drop))) {
+      ++drop;
+    }
+    auto rounded = divideRounded(mantissa, powerOfTen(drop));
+    if (!fits(rounded) && drop < scale) {
+      // Rounding up carried the value out of range.
+      rounded = divideRounded(mantissa, powerOfTen(++drop));
+    }
+    mantissa = rounded;
+    scale -= drop;
+  }
+  mantissa = std::min(std::max(mantissa, kMinMantissa), kMaxMantissa);
+  return Decimal::fromMantissa(static_cast<int64_t>(mantissa), scale);
+}
+
+Wide rescale(const Decimal& d, const int scale) {
+  return static_cast<Wide>(d.mantissa()) * kPowersOfTen[scale - d.scale()];
+}
+
+Decimal add(const Decimal& lhs, const Decimal& rhs, const bool subtract) {
+  if (lhs.empty() && rhs.empty()) {
+    return Decimal();
+  }
+  auto scale = std::max(lhs.scale(), rhs.scale());
+  auto r = rescale(rhs, scale);
+  return normalize(rescale(lhs, scale) + (subtract ? -r : r), scale);
+}
+} // namespace
+
+Decimal::Decimal(const char* str) {
+  if (str == nullptr) {
+    return;
+  }
+  if (auto status = parse(str, std::strlen(str), *this); !status.ok()) {
+    throw std::invalid_argument(status.getMessage());
+  }
+}
+
+Decimal::Decimal(const std::string& str) {
+  if (auto status = parse(str.data(), str.size(), *this); !status.ok()) {
+    throw std::invalid_argument(status.getMessage());
+  }
+}
+
+Decimal Decimal::fromMantissa(const int64_t mantissa, const int scale) {
+  Decimal d;
+  d.mantissa_ = mantissa;
+  d.scale_ = static_cast<int8_t>(std::min(std::max(scale, 0), kMaxScale));
+  d.empty_ = false;
+  return d;
+}
+
+Status Decimal::parse(const char* str, const size_t length, Decimal& out) {
+  if (length == 0) {
+    out = Decimal();
+    return Status();
+  }
+  auto invalid = [&]() { return Status(1, "Couldn't parse \"" + std::string(str, length) + "\" as a decimal"); };
+
+  size_t i = 0;
+  auto negative = str[0] == '-';
+  if (negative || str[0] == '+') {
+    ++i;
+  }
+
+  Wide mantissa = 0;
+  int scale = 0;
+  auto digits = false;
+  auto point = false;
+  auto full = false;
+  for (; i < length; ++i) {
+    auto c = str[i];
+    if (c == '.' && !point) {
+      point = true;
+      continue;
+    }
+    if (c < '0' || c > '9') {
+      return invalid();
+    }
+    digits = true;
+    auto digit = c - '0';
+    if (!point) {
+      mantissa = mantissa * 10 + digit;
+      if (mantissa > kMaxMantissa) {
+        return Status(1, "Couldn't parse \"" + std::string(str, length) + "\" as a decimal: it is out of range");
+      }
+    } else if (!full && (scale == kMaxScale || mantissa * 10 + digit > kMaxMantissa)) {
+      // Round on the first digit which doesn't fit and ignore the rest.
+      full = true;
+      if (digit >= 5) {
+        ++mantissa;
+      }
+    } else if (!full) {
+      mantissa = mantissa * 10 + digit;
+      ++scale;
+    }
+  }
+  if (!digits) {
+    return invalid();
+  }
+  out = normalize(negative ? -mantissa : mantissa, scale);
+  return Status();
+}
+
+double Decimal::toDouble() const {
+  return static_cast<double>(mantissa_) / static_cast<double>(kPowersOfTen[scale_]);
+}
+
+std::string Decimal::toString() const {
+  if (empty_) {
+    return "";
+  }
+  auto magnitude = mantissa_ < 0 ? 0 - static_cast<uint64_t>(mantissa_) : static_cast<uint64_t>(mantissa_);
+  auto s = std::to_string(magnitude);
+  if (scale_ > 0) {
+    size_t scale = scale_;
+    if (s.size() <= scale) {
+      s.insert(0, scale - s.size() + 1, '0');
+    }
+    s.insert(s.size() - scale, 1, '.');
+  }
+  if (mantissa_ < 0) {
+    s.insert(0, 1, '-');
+  }
+  return s;
+}
+
+Decimal Decimal::operator-() const {
+  if (empty_) {
+    return Decimal();
+  }
+  return normalize(-static_cast<Wide>(mantissa_), scale_);
+}
+
+Decimal operator+(const Decimal& lhs, const Decimal& rhs) {
+  return add(lhs, rhs, false);
+}
+
+Decimal operator-(const Decimal& lhs, const Decimal& rhs) {
+  return add(lhs, rhs, true);
+}
+
+Decimal operator*(const Decimal& lhs, const Decimal& rhs) {
+  if (lhs.empty_ && rhs.empty_) {
+    return Decimal();
+  }
+  return normalize(static_cast<Wide>(lhs.mantissa_) * rhs.mantissa_, lhs.scale_ + rhs.scale_);
+}
+
+Decimal& Decimal::operator+=(const Decimal& rhs) {
+  return *this = *this + rhs;
+}
+
+Decimal& Decimal::operator-=(const Decimal& rhs) {
+  return *this = *this - rhs;
+}
+
+Decimal& Decimal::operator*=(const Decimal& rhs) {
+  return *this = *this * rhs;
+}
+
+int Decimal::compare(const Decimal& lhs, const Decimal& rhs) {
+  if (lhs.empty_ || rhs.empty_) {
+    return static_cast<int>(rhs.empty_) - static_cast<int>(lhs.empty_);
+  }
+  auto scale = std::max(lhs.scale_, rhs.scale_);
+  auto l = rescale(lhs, scale);
+  auto r = rescale(rhs, scale);
+  return l < r ? -1 : (l > r ? 1 : 0);
+}
+
+bool operator==(const Decimal& lhs, const Decimal& rhs) {
+  return Decimal::compare(lhs, rhs) == 0;
+}
+
+bool operator!=(const Decimal& lhs, const Decimal& rhs) {
+  return Decimal::compare(lhs, rhs) != 0;
+}
+
+bool operator<(const Decimal& lhs, const Decimal& rhs) {
+  return Decimal::compare(lhs, rhs) < 0;
+}
+
+bool operator<=(const Decimal& lhs, const Decimal& rhs) {
+  return Decimal::compare(lhs, rhs) <= 0;
+}
+
+bool operator>(const Decimal& lhs, const Decimal& rhs) {
+  return Decimal::compare(lhs, rhs) > 0;
+}
+
+bool operator>=(const Decimal& lhs, const Decimal& rhs) {
+  return Decimal::compare(lhs, rhs) >= 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const Decimal& d) {
+  return os << d.toString();
+}
+} // namespace alpaca
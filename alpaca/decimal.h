@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "alpaca/status.h"
+
+namespace alpaca {
+
+/**
+ * @brief A fixed-point decimal number, used for prices, quantities and
+ * amounts of money.
+ *
+ * The API sends these as strings such as "107.05". A Decimal keeps the digits
+ * as a 64-bit integer mantissa and the number of them which are fractional,
+ * so it is parsed once when a model is deserialized, is exact, and formats
+ * back to the string it was parsed from.
+ *
+ * A Decimal can be constructed from a string literal:
+ *
+ * @code{.cpp}
+ *   auto request = alpaca::OrderRequest();
+ *   request.limit_price = alpaca::Decimal("350.00");
+ *
+ *   if (position.market_value > alpaca::Decimal("10000")) {
+ *     LOG(INFO) << position.symbol << " is worth " << position.market_value;
+ *   }
+ * @endcode
+ *
+ * A default constructed Decimal is empty, which stands for a value that is
+ * null or missing. Empty decimals format as "", are equal to each other and
+ * order before every other value, and count as zero in arithmetic.
+ */
+class Decimal {
+ public:
+  /// The most fractional digits a Decimal keeps
+  static constexpr int kMaxScale = 18;
+
+  Decimal() = default;
+
+  /**
+   * @brief Parse a decimal string, such as a literal in the program.
+   *
+   * An empty string, or a null one, makes an empty Decimal. Use parse() for
+   * strings which may not be valid decimals.
+   *
+   * @throws std::invalid_argument if str is not a decimal.
+   */
+  explicit Decimal(const char* str);
+  explicit Decimal(const std::string& str);
+
+  /**
+   * @brief The Decimal whose value is mantissa / 10^scale.
+   *
+   * @param scale The number of fractional digits, from 0 to kMaxScale.
+   */
+  static Decimal fromMantissa(const int64_t mantissa, const int scale);
+
+  /**
+   * @brief Parse a string such as "-12.50" into a Decimal.
+   *
+   * An empty string parses to an empty Decimal. Fractional digits beyond
+   * kMaxScale, or beyond what fits in the mantissa, are rounded half away from
+   * zero.
+   *
+   * @return a Status indicating the success or faliure of the operation. On
+   * faliure, out is left unchanged.
+   */
+  static Status parse(const char* str, const size_t length, Decimal& out);
+
+  /**
+   * @brief Whether the value is null or missing.
+   */
+  bool empty() const {
+    return empty_;
+  }
+
+  /**
+   * @brief The digits of the value, without the decimal point.
+   */
+  int64_t mantissa() const {
+    return mantissa_;
+  }
+
+  /**
+   * @brief The number of fractional digits.
+   */
+  int scale() const {
+    return scale_;
+  }
+
+  /**
+   * @brief The nearest double to the value, or zero if it is empty.
+   */
+  double toDouble() const;
+
+  /**
+   * @brief Format the value with as many fractional digits as it was parsed
+   * with, or "" if it is empty.
+   */
+  std::string toString() const;
+
+  /**
+   * @brief Exact arithmetic, except that results which don't fit are rounded
+   * to fewer fractional digits and, failing that, saturated.
+   */
+  Decimal operator-() const;
+  friend Decimal operator+(const Decimal& lhs, const Decimal& rhs);
+  friend Decimal operator-(const Decimal& lhs, const Decimal& rhs);
+  friend Decimal operator*(const Decimal& lhs, const Decimal& rhs);
+  Decimal& operator+=(const Decimal& rhs);
+  Decimal& operator-=(const Decimal& rhs);
+  Decimal& operator*=(const Decimal& rhs);
+
+  /**
+   * @brief Comparisons are by value, so "1.5" == "1.50".
+   */
+  friend bool operator==(const Decimal& lhs, const Decimal& rhs);
+  friend bool operator!=(const Decimal& lhs, const Decimal& rhs);
+  friend bool operator<(const Decimal& lhs, const Decimal& rhs);
+  friend bool operator<=(const Decimal& lhs, const Decimal& rhs);
+  friend bool operator>(const Decimal& lhs, const Decimal& rhs);
+  friend bool operator>=(const Decimal& lhs, const Decimal& rhs);
+
+  friend std::ostream& operator<<(std::ostream& os, const Decimal& d);
+
+ private:
+  /**
+   * @brief -1, 0 or 1 as lhs is less than, equal to or greater than rhs.
+   */
+  static int compare(const Decimal& lhs, const Decimal& rhs);
+
+ private:
+  int64_t mantissa_ = 0;
+  int8_t scale_ = 0;
+  bool empty_ = true;
+};
+} // namespace alpaca
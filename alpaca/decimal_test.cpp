@@ -0,0 +1,99 @@
+#include "alpaca/decimal.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class DecimalTest : public ::testing::Test {};
+
+TEST_F(DecimalTest, testParse) {
+  alpaca::Decimal d;
+  EXPECT_OK(alpaca::Decimal::parse("107.05", 6, d));
+  EXPECT_EQ(d.mantissa(), 10705);
+  EXPECT_EQ(d.scale(), 2);
+  EXPECT_FALSE(d.empty());
+
+  EXPECT_OK(alpaca::Decimal::parse("-0.0084", 7, d));
+  EXPECT_EQ(d.mantissa(), -84);
+  EXPECT_EQ(d.scale(), 4);
+
+  EXPECT_OK(alpaca::Decimal::parse("", 0, d));
+  EXPECT_TRUE(d.empty());
+
+  for (const std::string s : {"abc", "-", ".", "1.2.3", "1e5", "12 ", "99999999999999999999"}) {
+    d = alpaca::Decimal("5");
+    EXPECT_NOT_OK(alpaca::Decimal::parse(s.data(), s.size(), d));
+    EXPECT_EQ(d, alpaca::Decimal("5"));
+    EXPECT_THROW(alpaca::Decimal{s}, std::invalid_argument);
+  }
+}
+
+TEST_F(DecimalTest, testToString) {
+  for (const std::string s :
+       {"0", "107.00", "-12.5", "0.0084", "-0.001", "9223372036854775807", "1.000000000000000001"}) {
+    EXPECT_EQ(alpaca::Decimal(s).toString(), s);
+  }
+  EXPECT_EQ(alpaca::Decimal(".5").toString(), "0.5");
+  EXPECT_EQ(alpaca::Decimal("+3.").toString(), "3");
+  EXPECT_EQ(alpaca::Decimal().toString(), "");
+  EXPECT_EQ(alpaca::Decimal::fromMantissa(INT64_MIN, 2).toString(), "-92233720368547758.08");
+
+  std::ostringstream ss;
+  ss << alpaca::Decimal("350.00");
+  EXPECT_EQ(ss.str(), "350.00");
+}
+
+TEST_F(DecimalTest, testRounding) {
+  EXPECT_EQ(alpaca::Decimal("0.1234567890123456789").toString(), "0.123456789012345679");
+  EXPECT_EQ(alpaca::Decimal("-0.1234567890123456781").toString(), "-0.123456789012345678");
+  EXPECT_EQ(alpaca::Decimal("123456789.123456789123").toString(), "123456789.1234567891");
+}
+
+TEST_F(DecimalTest, testArithmetic) {
+  EXPECT_EQ((alpaca::Decimal("0.1") + alpaca::Decimal("0.2")).toString(), "0.3");
+  EXPECT_EQ((alpaca::Decimal("600.0") - alpaca::Decimal("500.25")).toString(), "99.75");
+  EXPECT_EQ((alpaca::Decimal("100.5") * alpaca::Decimal("3")).toString(), "301.5");
+  EXPECT_EQ((alpaca::Decimal("1.05") * alpaca::Decimal("-1.05")).toString(), "-1.1025");
+  EXPECT_EQ((-alpaca::Decimal("2.50")).toString(), "-2.50");
+  EXPECT_EQ((alpaca::Decimal("7") + alpaca::Decimal()).toString(), "7");
+  EXPECT_TRUE((alpaca::Decimal() + alpaca::Decimal()).empty());
+
+  auto total = alpaca::Decimal("0");
+  for (int i = 0; i < 10; ++i) {
+    total += alpaca::Decimal("0.01");
+  }
+  EXPECT_EQ(total, alpaca::Decimal("0.1"));
+
+  // Too many fractional digits are rounded away, and too many integer digits saturate.
+  EXPECT_EQ((alpaca::Decimal("0.000000001") * alpaca::Decimal("0.0000000015")).toString(), "0.000000000000000002");
+  // Dropped digits are rounded once rather than one at a time.
+  EXPECT_EQ((alpaca::Decimal("0.0000000000449") * alpaca::Decimal("0.0000001")).toString(), "0.000000000000000004");
+  EXPECT_EQ((alpaca::Decimal("-0.0000000000449") * alpaca::Decimal("0.0000001")).toString(), "-0.000000000000000004");
+  EXPECT_EQ((alpaca::Decimal("0.000000000045") * alpaca::Decimal("0.0000001")).toString(), "0.000000000000000005");
+  auto max = alpaca::Decimal("9223372036854775807");
+  EXPECT_EQ((max + alpaca::Decimal("1")).toString(), "9223372036854775807");
+  EXPECT_EQ((max * alpaca::Decimal("-2")).toString(), "-9223372036854775808");
+}
+
+TEST_F(DecimalTest, testCompare) {
+  EXPECT_EQ(alpaca::Decimal("1.5"), alpaca::Decimal("1.50"));
+  EXPECT_NE(alpaca::Decimal("1.5"), alpaca::Decimal("1.51"));
+  EXPECT_LT(alpaca::Decimal("-2"), alpaca::Decimal("-1.999"));
+  EXPECT_GT(alpaca::Decimal("100"), alpaca::Decimal("99.99"));
+  EXPECT_LE(alpaca::Decimal("0.0"), alpaca::Decimal("0"));
+  EXPECT_GE(alpaca::Decimal("9223372036854775807"), alpaca::Decimal("922337203685477580.7"));
+
+  EXPECT_EQ(alpaca::Decimal(), alpaca::Decimal(""));
+  EXPECT_EQ(alpaca::Decimal(), alpaca::Decimal(static_cast<const char*>(nullptr)));
+  EXPECT_NE(alpaca::Decimal(), alpaca::Decimal("0"));
+  EXPECT_LT(alpaca::Decimal(), alpaca::Decimal("-100"));
+}
+
+TEST_F(DecimalTest, testToDouble) {
+  EXPECT_DOUBLE_EQ(alpaca::Decimal("107.05").toDouble(), 107.05);
+  EXPECT_DOUBLE_EQ(alpaca::Decimal("-0.0084").toDouble(), -0.0084);
+  EXPECT_EQ(alpaca::Decimal().toDouble(), 0);
+}
@@ -0,0 +1,55 @@
+#include "alpaca/enum.h"
+
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace alpaca {
+
+namespace detail {
+namespace {
+/**
+ * @brief The strings which didn't name a value of an enum.
+ *
+ * Strings are only ever added, and the deque doesn't move them when it
+ * grows, so references to them stay valid without holding the lock.
+ */
+struct UnknownEnumNames {
+  UnknownEnumNames() {
+    names.emplace_back();
+  }
+
+  std::mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string_view, uint32_t> ids;
+};
+
+UnknownEnumNames& unknownEnumNames() {
+  static UnknownEnumNames names;
+  return names;
+}
+} // namespace
+
+uint32_t internUnknownEnumName(const char* str, const size_t length) {
+  if (length == 0) {
+    return 0;
+  }
+  auto& table = unknownEnumNames();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  if (auto it = table.ids.find(std::string_view(str, length)); it != table.ids.end()) {
+    return it->second;
+  }
+  auto id = static_cast<uint32_t>(table.names.size());
+  const auto& name = table.names.emplace_back(str, length);
+  table.ids.emplace(name, id);
+  return id;
+}
+
+const std::string& unknownEnumName(const uint32_t id) {
+  auto& table = unknownEnumNames();
+  std::lock_guard<std::mutex> lock(table.mutex);
+  return table.names[id];
+}
+} // namespace detail
+} // namespace alpaca
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace alpaca {
+
+/**
+ * @brief The JSON string of a value of an enum.
+ */
+template <typename E>
+struct EnumName {
+  constexpr EnumName(const char* n, const E v) : name(n), length(std::char_traits<char>::length(n)), value(v) {}
+
+  const char* name;
+  size_t length;
+  E value;
+};
+
+/**
+ * @brief Lists the JSON strings of the values of an enum which is parsed from
+ * the API. Each such enum specializes this with a kNames array:
+ *
+ * @code{.cpp}
+ *   template <>
+ *   struct EnumTraits<PositionSide> {
+ *     static constexpr EnumName<PositionSide> kNames[] = {
+ *         {"long", PositionSide::Long},
+ *         {"short", PositionSide::Short},
+ *     };
+ *   };
+ * @endcode
+ */
+template <typename E>
+struct EnumTraits;
+
+namespace detail {
+/**
+ * @brief Keep a copy of a string which didn't name any value of an enum, for
+ * the lifetime of the process.
+ *
+ * @return an identifier of the copy, which is zero for an empty string.
+ */
+uint32_t internUnknownEnumName(const char* str, const size_t length);
+
+/**
+ * @brief The string kept by internUnknownEnumName().
+ */
+const std::string& unknownEnumName(const uint32_t id);
+} // namespace detail
+
+/**
+ * @brief A value of an enum which was parsed from a JSON string.
+ *
+ * Strings which don't name a value parse to E::Unknown, and the string is
+ * kept so that toString() still returns it. The value converts to E, so it
+ * can be compared with or switched on directly:
+ *
+ * @code{.cpp}
+ *   if (order.status == alpaca::OrderStatus::Filled) {
+ *     LOG(INFO) << "Order " << order.id << " is " << order.status;
+ *   }
+ * @endcode
+ *
+ * An Enum is the size of a pointer, since the strings of unknown values are
+ * interned in a table which is shared by the process.
+ */
+template <typename E>
+class Enum {
+ public:
+  constexpr Enum() = default;
+  constexpr Enum(const E value) : value_(value) {}
+
+  /**
+   * @brief Parse the JSON string of a value.
+   */
+  static Enum parse(const char* str, const size_t length) {
+    for (const auto& name : EnumTraits<E>::kNames) {
+      if (name.length == length && std::memcmp(name.name, str, length) == 0) {
+        return Enum(name.value);
+      }
+    }
+    Enum e;
+    e.unknown_ = detail::internUnknownEnumName(str, length);
+    return e;
+  }
+
+  constexpr E value() const {
+    return value_;
+  }
+
+  constexpr operator E() const {
+    return value_;
+  }
+
+  /**
+   * @brief The JSON string of the value. For an unknown value, this is the
+   * string which was parsed, or "" if there wasn't one.
+   */
+  std::string toString() const {
+    if (value_ == E::Unknown) {
+      return detail::unknownEnumName(unknown_);
+    }
+    for (const auto& name : EnumTraits<E>::kNames) {
+      if (name.value == value_) {
+        return std::string(name.name, name.length);
+      }
+    }
+    return "";
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const Enum& e) {
+    return os << e.toString();
+  }
+
+ private:
+  E value_ = E::Unknown;
+
+  /// The interned string of an unknown value
+  uint32_t unknown_ = 0;
+};
+} // namespace alpaca
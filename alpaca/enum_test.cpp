@@ -0,0 +1,67 @@
+#include "alpaca/enum.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alpaca/order.h"
+#include "gtest/gtest.h"
+
+class EnumTest : public ::testing::Test {};
+
+TEST_F(EnumTest, testParse) {
+  auto status = alpaca::Enum<alpaca::OrderStatus>::parse("partially_filled", 16);
+  EXPECT_EQ(status, alpaca::OrderStatus::PartiallyFilled);
+  EXPECT_EQ(status.toString(), "partially_filled");
+
+  switch (alpaca::Enum<alpaca::OrderSide>::parse("sell", 4)) {
+  case alpaca::OrderSide::Sell:
+    break;
+  default:
+    FAIL() << "Expected a sell";
+  }
+
+  EXPECT_EQ(alpaca::Enum<alpaca::OrderStatus>::parse("fill", 4), alpaca::OrderStatus::Unknown);
+  EXPECT_EQ(alpaca::Enum<alpaca::OrderStatus>::parse("filled_", 7), alpaca::OrderStatus::Unknown);
+}
+
+TEST_F(EnumTest, testUnknown) {
+  auto type = alpaca::Enum<alpaca::OrderType>::parse("trailing_stop", 13);
+  EXPECT_EQ(type, alpaca::OrderType::Unknown);
+  EXPECT_EQ(type.toString(), "trailing_stop");
+  EXPECT_EQ(alpaca::Enum<alpaca::OrderType>::parse("trailing_stop", 13).toString(), "trailing_stop");
+  EXPECT_EQ(alpaca::Enum<alpaca::OrderType>::parse("trailing_limit", 14).toString(), "trailing_limit");
+
+  alpaca::Enum<alpaca::OrderType> missing;
+  EXPECT_EQ(missing, alpaca::OrderType::Unknown);
+  EXPECT_EQ(missing.toString(), "");
+  EXPECT_EQ(alpaca::Enum<alpaca::OrderType>::parse("", 0).toString(), "");
+
+  std::ostringstream ss;
+  ss << type << " " << alpaca::Enum<alpaca::OrderType>(alpaca::OrderType::StopLimit);
+  EXPECT_EQ(ss.str(), "trailing_stop stop_limit");
+}
+
+TEST_F(EnumTest, testUnknownFromThreads) {
+  std::vector<std::thread> threads;
+  std::vector<std::string> names(8);
+  for (size_t i = 0; i < names.size(); ++i) {
+    threads.emplace_back([&names, i]() {
+      auto name = "unknown_" + std::to_string(i % 2);
+      for (int j = 0; j < 1000; ++j) {
+        names[i] = alpaca::Enum<alpaca::OrderStatus>::parse(name.data(), name.size()).toString();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < names.size(); ++i) {
+    EXPECT_EQ(names[i], "unknown_" + std::to_string(i % 2));
+  }
+}
+
+TEST_F(EnumTest, testSize) {
+  EXPECT_LE(sizeof(alpaca::Enum<alpaca::OrderStatus>), sizeof(void*));
+}
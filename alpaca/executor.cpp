@@ -0,0 +1,133 @@
+#include "alpaca/executor.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "glog/logging.h"
+
+namespace alpaca {
+
+Executor::Executor(size_t threads) : threads_(threads > 0 ? threads : 1), state_(std::make_shared<State>()) {}
+
+Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->stopping = true;
+  }
+  state_->cv.notify_all();
+
+  for (auto& worker : workers_) {
+    if (worker.get_id() == std::this_thread::get_id()) {
+      // The last reference to the executor was released by one of its own
+      // tasks. The thread keeps the shared state alive and exits on its own.
+      worker.detach();
+    } else {
+      worker.join();
+    }
+  }
+}
+
+void Executor::post(std::function<void()> task) {
+  start();
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->tasks.push_back(std::move(task));
+  }
+  state_->cv.notify_one();
+}
+
+void Executor::postAt(const std::chrono::steady_clock::time_point time, std::function<void()> task) {
+  start();
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->delayed.emplace(time, std::move(task));
+  }
+  // The task may be due before the one which the idle threads wait for.
+  state_->cv.notify_one();
+}
+
+size_t Executor::getThreads() const {
+  return threads_;
+}
+
+void Executor::start() {
+  std::call_once(started_, [this]() {
+    DLOG(INFO) << "Starting executor with " << threads_ << " threads";
+    workers_.reserve(threads_);
+    for (size_t i = 0; i < threads_; ++i) {
+      workers_.emplace_back(&Executor::work, state_);
+    }
+  });
+}
+
+void Executor::work(std::shared_ptr<State> state) {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      while (true) {
+        auto now = std::chrono::steady_clock::now();
+        auto& delayed = state->delayed;
+        size_t due = 0;
+        for (; !delayed.empty() && delayed.begin()->first <= now; ++due) {
+          state->tasks.push_back(std::move(delayed.begin()->second));
+          delayed.erase(delayed.begin());
+        }
+        if (due > 1) {
+          // Only this thread was woken for them, so wake others to share them.
+          state->cv.notify_all();
+        }
+        if (!state->tasks.empty()) {
+          break;
+        }
+        if (state->stopping) {
+          return;
+        }
+        if (delayed.empty()) {
+          state->cv.wait(lock);
+        } else {
+          state->cv.wait_until(lock, delayed.begin()->first);
+        }
+      }
+      task = std::move(state->tasks.front());
+      state->tasks.pop_front();
+    }
+    task();
+  }
+}
+
+void parallelFor(Executor& executor, size_t n, size_t max_concurrency, const std::function<void(size_t)>& fn) {
+  // Helpers may start after this call has returned, so they share the
+  // progress by reference count and only touch fn for work they claimed.
+  struct Progress {
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t completed = 0;
+  };
+  auto progress = std::make_shared<Progress>();
+  auto work = [progress, n, &fn]() {
+    size_t done = 0;
+    for (auto i = progress->next++; i < n; i = progress->next++) {
+      fn(i);
+      ++done;
+    }
+    if (done > 0) {
+      std::lock_guard<std::mutex> lock(progress->mutex);
+      progress->completed += done;
+      if (progress->completed == n) {
+        progress->cv.notify_all();
+      }
+    }
+  };
+
+  auto threads = std::min(std::max<size_t>(max_concurrency, 1), n);
+  for (size_t i = 1; i < threads; ++i) {
+    executor.post(work);
+  }
+  work();
+
+  std::unique_lock<std::mutex> lock(progress->mutex);
+  progress->cv.wait(lock, [&progress, n]() { return progress->completed == n; });
+}
+} // namespace alpaca
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alpaca {
+
+/**
+ * @brief A bounded pool of I/O threads which runs queued tasks.
+ *
+ * Threads are started lazily on the first submitted task, so an executor that
+ * is never used costs nothing. Tasks which are still queued when the executor
+ * is destroyed are run before the threads exit, and delayed tasks which are
+ * not yet due are dropped.
+ *
+ * @code{.cpp}
+ *   auto executor = alpaca::Executor(4);
+ *   auto future = executor.submit([] { return 42; });
+ *   LOG(INFO) << "The answer is " << future.get();
+ * @endcode
+ */
+class Executor {
+ public:
+  /**
+   * @brief The primary constructor.
+   *
+   * @param threads The maximum number of threads which will run tasks.
+   */
+  explicit Executor(size_t threads);
+
+  /**
+   * @brief The default constructor of Executor should never be used.
+   */
+  explicit Executor() = delete;
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  ~Executor();
+
+  /**
+   * @brief Queue a task to be run on one of the executor's threads.
+   */
+  void post(std::function<void()> task);
+
+  /**
+   * @brief Queue a task to be run once a time has been reached.
+   *
+   * Until then the task only sits in a queue ordered by time, which idle
+   * threads wait on, so a delayed task does not hold a thread. Once due, it
+   * runs behind the tasks which are already queued.
+   */
+  void postAt(std::chrono::steady_clock::time_point time, std::function<void()> task);
+
+  /**
+   * @brief Queue a task and return a std::future for its result.
+   *
+   * @return a std::future which becomes ready when the task has run. If the
+   * task throws, the exception is rethrown by std::future::get().
+   */
+  template <typename F>
+  std::future<std::invoke_result_t<F>> submit(F&& f) {
+    using R = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    auto future = task->get_future();
+    post([task]() { (*task)(); });
+    return future;
+  }
+
+  /**
+   * @brief The maximum number of threads which will run tasks.
+   */
+  size_t getThreads() const;
+
+ private:
+  /**
+   * @brief The state shared between the executor and its threads.
+   *
+   * Threads hold their own reference to the state so that an executor which
+   * is destroyed from one of its own threads can safely detach it.
+   */
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> delayed;
+    bool stopping = false;
+  };
+
+  /**
+   * @brief Start the threads, if they haven't been started yet.
+   */
+  void start();
+
+  /**
+   * @brief The loop run by each thread until the executor is stopped.
+   */
+  static void work(std::shared_ptr<State> state);
+
+ private:
+  size_t threads_;
+  std::shared_ptr<State> state_;
+  std::once_flag started_;
+  std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief Call fn(i) for every i in [0, n) with at most max_concurrency calls
+ * running at once, and return when all of them have completed.
+ *
+ * The calling thread takes part in the work and up to max_concurrency - 1
+ * helpers are queued on the executor, so a max_concurrency of one runs every
+ * call sequentially on the calling thread. Helpers which only start once all
+ * of the work has been claimed return straight away, so this is safe to call
+ * from one of the executor's own threads even when the executor is busy.
+ */
+void parallelFor(Executor& executor, size_t n, size_t max_concurrency, const std::function<void(size_t)>& fn);
+} // namespace alpaca
@@ -0,0 +1,138 @@
+#include "alpaca/executor.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class ExecutorTest : public ::testing::Test {};
+
+TEST_F(ExecutorTest, testSubmit) {
+  alpaca::Executor executor(2);
+  auto future = executor.submit([]() { return 42; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST_F(ExecutorTest, testSubmitPropagatesExceptions) {
+  alpaca::Executor executor(1);
+  auto future = executor.submit([]() -> int { throw std::runtime_error("failed"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST_F(ExecutorTest, testDestructorDrainsQueuedTasks) {
+  std::atomic<int> counter{0};
+  {
+    alpaca::Executor executor(2);
+    for (int i = 0; i < 100; ++i) {
+      executor.post([&counter]() { counter++; });
+    }
+  }
+  EXPECT_EQ(counter, 100);
+}
+
+TEST_F(ExecutorTest, testPostAt) {
+  alpaca::Executor executor(1);
+  std::mutex mutex;
+  std::vector<int> order;
+  auto start = std::chrono::steady_clock::now();
+  std::promise<std::chrono::steady_clock::time_point> ran;
+  executor.postAt(start + std::chrono::milliseconds(40), [&]() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(2);
+    }
+    ran.set_value(std::chrono::steady_clock::now());
+  });
+  executor.postAt(start + std::chrono::milliseconds(20), [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(1);
+  });
+  // A delayed task doesn't hold the only thread.
+  EXPECT_EQ(executor.submit([]() { return 42; }).get(), 42);
+
+  EXPECT_GE(ran.get_future().get() - start, std::chrono::milliseconds(40));
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(order, std::vector<int>({1, 2}));
+}
+
+TEST_F(ExecutorTest, testDestructorDropsDelayedTasks) {
+  std::atomic<int> counter{0};
+  {
+    alpaca::Executor executor(2);
+    executor.postAt(std::chrono::steady_clock::now(), [&counter]() { counter++; });
+    executor.postAt(std::chrono::steady_clock::now() + std::chrono::hours(1), [&counter]() { counter += 10; });
+    executor.submit([]() {}).get();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(counter, 1);
+}
+
+TEST_F(ExecutorTest, testThreadsAreBounded) {
+  alpaca::Executor executor(3);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 30; ++i) {
+    futures.push_back(executor.submit([&running, &max_running]() {
+      auto now = ++running;
+      auto seen = max_running.load();
+      while (now > seen && !max_running.compare_exchange_weak(seen, now)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      running--;
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  EXPECT_LE(max_running, 3);
+  EXPECT_EQ(executor.getThreads(), 3);
+}
+
+TEST_F(ExecutorTest, testParallelFor) {
+  alpaca::Executor executor(8);
+  std::vector<int> results(1000, 0);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  alpaca::parallelFor(executor, results.size(), 4, [&](size_t i) {
+    auto now = ++running;
+    auto seen = max_running.load();
+    while (now > seen && !max_running.compare_exchange_weak(seen, now)) {
+    }
+    results[i] = i * 2;
+    running--;
+  });
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i], i * 2);
+  }
+  EXPECT_LE(max_running, 4);
+}
+
+TEST_F(ExecutorTest, testParallelForEmpty) {
+  alpaca::Executor executor(2);
+  auto calls = 0;
+  alpaca::parallelFor(executor, 0, 4, [&calls](size_t) { calls++; });
+  EXPECT_EQ(calls, 0);
+}
+
+TEST_F(ExecutorTest, testParallelForFromBusyExecutor) {
+  // Every thread of the executor is running a parallelFor, so none of their
+  // helpers can start until the callers have done all of the work.
+  alpaca::Executor executor(2);
+  std::vector<std::future<int>> futures;
+  for (auto i = 0; i < 2; ++i) {
+    futures.push_back(executor.submit([&executor]() {
+      std::atomic<int> sum{0};
+      alpaca::parallelFor(executor, 100, 4, [&sum](size_t j) { sum += j; });
+      return sum.load();
+    }));
+  }
+  for (auto& future : futures) {
+    EXPECT_EQ(future.get(), 4950);
+  }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "alpaca/executor.h"
+
+namespace alpaca {
+
+/**
+ * @brief One of the two attempts of a hedged call.
+ *
+ * An attempt which blocks can register how to interrupt it for as long as it
+ * is in flight, so that it returns early once the other attempt has succeeded.
+ */
+class HedgedAttempt {
+ public:
+  HedgedAttempt() = default;
+  HedgedAttempt(const HedgedAttempt&) = delete;
+  HedgedAttempt& operator=(const HedgedAttempt&) = delete;
+
+  /**
+   * @brief Set how to interrupt the attempt, or clear it with nullptr once the
+   * attempt can no longer be interrupted.
+   *
+   * cancel is never called after it has been cleared, so it may refer to
+   * state which only lives until then.
+   *
+   * @return false if the attempt has already been cancelled, in which case it
+   * should not start.
+   */
+  bool onCancel(std::function<void()> cancel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancel_ = std::move(cancel);
+    return !cancelled_;
+  }
+
+  /**
+   * @brief Interrupt the attempt, or stop it from starting.
+   */
+  void cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    if (cancel_) {
+      cancel_();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::function<void()> cancel_;
+  bool cancelled_ = false;
+};
+
+/**
+ * @brief Make a call, and hedge it with a second call if the first one has not
+ * completed by the deadline.
+ *
+ * The first call runs on the calling thread and only the hedge is queued on
+ * the executor, so time spent waiting for an executor thread delays the hedge
+ * rather than the call. The hedge is queued with Executor::postAt(), so it
+ * only takes a thread once the deadline has passed, and it is only sent if
+ * the first call is still in flight and may_hedge() allows it then. If the hedge succeeds first, the first call is
+ * cancelled through its HedgedAttempt. A hedge which loses is left to finish
+ * in the background.
+ *
+ * @code{.cpp}
+ *   auto body = alpaca::hedge<std::string>(
+ *       executor,
+ *       std::chrono::steady_clock::now() + std::chrono::milliseconds(50),
+ *       []() { return true; },
+ *       [&](alpaca::HedgedAttempt&) { return fetch("/v2/clock"); },
+ *       [](const std::string& body) { return !body.empty(); });
+ * @endcode
+ *
+ * @return the first successful result, or the first result if neither call
+ * succeeded.
+ */
+template <typename T>
+T hedge(Executor& executor,
+        const std::chrono::steady_clock::time_point deadline,
+        std::function<bool()> may_hedge,
+        std::function<T(HedgedAttempt&)> call,
+        std::function<bool(const T&)> succeeded) {
+  // The state is shared with the hedge, which may outlive this call.
+  struct Race {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t sent = 1;
+    size_t finished = 0;
+    bool answered = false;
+    bool succeeded = false;
+    T result;
+    HedgedAttempt first;
+
+    void finish(T&& value, const bool success) {
+      ++finished;
+      if (!answered || (success && !succeeded)) {
+        answered = true;
+        succeeded = success;
+        result = std::move(value);
+      }
+      cv.notify_all();
+    }
+  };
+  auto race = std::make_shared<Race>();
+
+  executor.postAt(deadline, [race, may_hedge = std::move(may_hedge), call, succeeded]() {
+    {
+      std::lock_guard<std::mutex> lock(race->mutex);
+      if (race->finished > 0 || !may_hedge()) {
+        return;
+      }
+      race->sent = 2;
+    }
+
+    HedgedAttempt attempt;
+    auto result = call(attempt);
+    auto success = succeeded(result);
+    bool cancel_first;
+    {
+      std::lock_guard<std::mutex> lock(race->mutex);
+      cancel_first = success && race->finished == 0;
+      race->finish(std::move(result), success);
+    }
+    if (cancel_first) {
+      race->first.cancel();
+    }
+  });
+
+  auto result = call(race->first);
+  auto success = succeeded(result);
+  std::unique_lock<std::mutex> lock(race->mutex);
+  race->finish(std::move(result), success);
+  race->cv.wait(lock, [&race]() { return race->succeeded || race->finished == race->sent; });
+  return race->result;
+}
+} // namespace alpaca
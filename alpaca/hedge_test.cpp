@@ -0,0 +1,160 @@
+#include "alpaca/hedge.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class HedgeTest : public ::testing::Test {};
+
+namespace {
+bool nonEmpty(const std::string& s) {
+  return !s.empty();
+}
+
+/**
+ * @brief A fake request which blocks until it is cancelled on its first call
+ * and answers straight away on every later call.
+ */
+class SlowThenFast {
+ public:
+  std::string operator()(alpaca::HedgedAttempt& attempt) {
+    if (calls_++ > 0) {
+      return "fast";
+    }
+    if (!attempt.onCancel([this]() {
+          std::lock_guard<std::mutex> lock(mutex_);
+          cancelled_ = true;
+          cv_.notify_all();
+        })) {
+      return "";
+    }
+    bool cancelled;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cancelled = cv_.wait_for(lock, std::chrono::seconds(10), [this]() { return cancelled_; });
+    }
+    attempt.onCancel(nullptr);
+    return cancelled ? "" : "slow";
+  }
+
+  int calls() const {
+    return calls_;
+  }
+
+ private:
+  std::atomic<int> calls_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool cancelled_ = false;
+};
+} // namespace
+
+TEST_F(HedgeTest, testFastCallIsNotHedged) {
+  alpaca::Executor executor(2);
+  std::atomic<int> calls{0};
+  auto result = alpaca::hedge<std::string>(
+      executor,
+      std::chrono::steady_clock::now() + std::chrono::seconds(10),
+      []() { return true; },
+      [&calls](alpaca::HedgedAttempt&) {
+        ++calls;
+        return std::string("first");
+      },
+      &nonEmpty);
+  EXPECT_EQ(result, "first");
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_F(HedgeTest, testSlowCallIsHedged) {
+  alpaca::Executor executor(2);
+  SlowThenFast request;
+  auto start = std::chrono::steady_clock::now();
+  auto result = alpaca::hedge<std::string>(
+      executor,
+      start + std::chrono::milliseconds(20),
+      []() { return true; },
+      [&request](alpaca::HedgedAttempt& attempt) { return request(attempt); },
+      &nonEmpty);
+  EXPECT_EQ(result, "fast");
+  EXPECT_EQ(request.calls(), 2);
+  // The slow call was interrupted rather than waited for.
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST_F(HedgeTest, testHedgeNeedsPermission) {
+  alpaca::Executor executor(2);
+  std::atomic<int> calls{0};
+  auto result = alpaca::hedge<std::string>(
+      executor,
+      std::chrono::steady_clock::now(),
+      []() { return false; },
+      [&calls](alpaca::HedgedAttempt&) {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return std::string("first");
+      },
+      &nonEmpty);
+  EXPECT_EQ(result, "first");
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_F(HedgeTest, testPrimaryDoesNotWaitForExecutor) {
+  // The only executor thread is busy, so the hedge can't be sent, but the
+  // first call still runs on the calling thread.
+  std::mutex mutex;
+  std::unique_lock<std::mutex> busy(mutex);
+  alpaca::Executor executor(1);
+  executor.post([&mutex]() { std::lock_guard<std::mutex> lock(mutex); });
+
+  auto result = alpaca::hedge<std::string>(
+      executor,
+      std::chrono::steady_clock::now(),
+      []() { return true; },
+      [](alpaca::HedgedAttempt&) { return std::string("first"); },
+      &nonEmpty);
+  EXPECT_EQ(result, "first");
+  busy.unlock();
+}
+
+TEST_F(HedgeTest, testWaitingHedgesDoNotHoldThreads) {
+  // Hedges which aren't due yet leave the executor's only thread free while
+  // the first calls are in flight.
+  alpaca::Executor executor(1);
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::atomic<int> started{0};
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 8; ++i) {
+    callers.emplace_back([&]() {
+      auto result = alpaca::hedge<std::string>(
+          executor,
+          std::chrono::steady_clock::now() + std::chrono::seconds(10),
+          []() { return true; },
+          [&](alpaca::HedgedAttempt&) {
+            ++started;
+            released.wait();
+            return std::string("first");
+          },
+          &nonEmpty);
+      EXPECT_EQ(result, "first");
+    });
+  }
+  while (started < 8) {
+    std::this_thread::yield();
+  }
+
+  auto other = executor.submit([]() { return 42; });
+  EXPECT_EQ(other.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  release.set_value();
+  for (auto& caller : callers) {
+    caller.join();
+  }
+}
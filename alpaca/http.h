@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * @brief Includes cpp-httplib with TLS session resumption.
+ *
+ * cpp-httplib has no hook to run before a TLS handshake, so its calls to
+ * SSL_connect() are routed through alpaca::detail::connectTLS(), which sets a
+ * session from the TLSSessionCache installed on the connection's SSL_CTX
+ * before connecting. httplib.h must always be included through this header:
+ * a translation unit which includes httplib.h first would compile cpp-httplib
+ * without the hook. That fails the build below, and TLSSessionCache logs a
+ * warning when it sees a handshake which didn't go through the hook, which
+ * catches a translation unit that never includes this header at all.
+ */
+
+#ifdef CPPHTTPLIB_HTTPLIB_H
+#error "httplib.h was included before alpaca/http.h, so TLS sessions would not be resumed"
+#endif
+
+#include <openssl/ssl.h>
+
+#include "alpaca/tls_session_cache.h"
+
+#define SSL_connect ::alpaca::detail::connectTLS
+#include "httplib.h"
+#undef SSL_connect
@@ -0,0 +1,245 @@
+#include "alpaca/incremental_parser.h"
+
+#include <sstream>
+
+#include "alpaca/parse_arena.h"
+#include "rapidjson/encodedstream.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
+
+namespace alpaca {
+
+namespace {
+bool isWhitespace(const char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * @brief A rapidjson SAX handler which captures a string, and rejects
+ * anything else.
+ */
+struct KeyHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, KeyHandler> {
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    key.assign(str, length);
+    return true;
+  }
+
+  bool Default() {
+    return false;
+  }
+
+  std::string key;
+};
+} // namespace
+
+IncrementalParser::IncrementalParser(ElementCallback on_element, KeyCallback on_key)
+    : on_element_(std::move(on_element)), on_key_(std::move(on_key)) {}
+
+bool IncrementalParser::feed(const char* data, size_t length) {
+  size_t i = 0;
+  while (i < length && state_ != Failed) {
+    if (state_ == InKey || state_ == InElement) {
+      i += readToken(data + i, length - i);
+    } else if (step(data[i])) {
+      ++i;
+      ++offset_;
+    }
+  }
+  return state_ != Failed;
+}
+
+Status IncrementalParser::finish() {
+  if (state_ == BeforeList) {
+    syntaxError(rapidjson::kParseErrorDocumentEmpty, offset_);
+  } else if ((state_ == InKey || state_ == InElement) && in_string_) {
+    syntaxError(rapidjson::kParseErrorStringMissQuotationMark, offset_);
+  } else if (state_ != AfterList && state_ != Failed) {
+    auto code = object_ && state_ != BeforeElement && state_ != InElement && state_ != AfterElement
+                    ? rapidjson::kParseErrorObjectMissCommaOrCurlyBracket
+                    : rapidjson::kParseErrorArrayMissCommaOrSquareBracket;
+    syntaxError(code, offset_);
+  }
+  return status_;
+}
+
+bool IncrementalParser::step(const char c) {
+  if (isWhitespace(c)) {
+    return true;
+  }
+
+  switch (state_) {
+    case BeforeList:
+      if (c == '[') {
+        state_ = BeforeElement;
+      } else if (c == '{') {
+        object_ = true;
+        state_ = BeforeKey;
+      } else {
+        fail(Status(1, "Expected a JSON list"));
+      }
+      break;
+    case BeforeKey:
+      if (c == '}' && first_) {
+        state_ = AfterList;
+      } else if (c == '"') {
+        state_ = InKey;
+        startToken();
+        return false;
+      } else {
+        syntaxError(rapidjson::kParseErrorObjectMissName, offset_);
+      }
+      break;
+    case AfterKey:
+      if (c == ':') {
+        state_ = BeforeMemberList;
+      } else {
+        syntaxError(rapidjson::kParseErrorObjectMissColon, offset_);
+      }
+      break;
+    case BeforeMemberList:
+      if (c == '[') {
+        first_ = true;
+        state_ = BeforeElement;
+      } else {
+        fail(Status(1, "Expected a JSON list"));
+      }
+      break;
+    case BeforeElement:
+      if (c == ']' && first_) {
+        endList();
+      } else {
+        state_ = InElement;
+        startToken();
+        return false;
+      }
+      break;
+    case AfterElement:
+      if (c == ',') {
+        first_ = false;
+        state_ = BeforeElement;
+      } else if (c == ']') {
+        endList();
+      } else {
+        syntaxError(rapidjson::kParseErrorArrayMissCommaOrSquareBracket, offset_);
+      }
+      break;
+    case AfterMember:
+      if (c == ',') {
+        first_ = false;
+        state_ = BeforeKey;
+      } else if (c == '}') {
+        state_ = AfterList;
+      } else {
+        syntaxError(rapidjson::kParseErrorObjectMissCommaOrCurlyBracket, offset_);
+      }
+      break;
+    case AfterList:
+      syntaxError(rapidjson::kParseErrorDocumentRootNotSingular, offset_);
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+size_t IncrementalParser::readToken(const char* data, const size_t length) {
+  size_t end = 0;
+  bool ended = false;
+  while (end < length && !ended) {
+    auto c = data[end];
+    if (in_string_) {
+      if (escaped_) {
+        escaped_ = false;
+      } else if (c == '\\') {
+        escaped_ = true;
+      } else if (c == '"') {
+        in_string_ = false;
+        ended = depth_ == 0;
+      }
+    } else if (depth_ == 0 && (c == ',' || c == ']' || c == '}' || isWhitespace(c))) {
+      // The end of a number or literal, which belongs to the list.
+      ended = true;
+      break;
+    } else if (c == '"') {
+      in_string_ = true;
+    } else if (c == '{' || c == '[') {
+      ++depth_;
+    } else if ((c == '}' || c == ']') && depth_ > 0) {
+      ended = --depth_ == 0;
+    }
+    ++end;
+  }
+
+  offset_ += end;
+  if (!ended) {
+    token_.append(data, end);
+  } else if (token_.empty()) {
+    // Nothing came before this chunk, so the token is read where it is.
+    endToken(data, end);
+  } else {
+    token_.append(data, end);
+    endToken(token_.data(), token_.size());
+  }
+  return end;
+}
+
+void IncrementalParser::startToken() {
+  token_.clear();
+  token_offset_ = offset_;
+  depth_ = 0;
+  in_string_ = false;
+  escaped_ = false;
+}
+
+void IncrementalParser::endToken(const char* token, const size_t length) {
+  if (length == 0) {
+    syntaxError(rapidjson::kParseErrorValueInvalid, token_offset_);
+    return;
+  }
+
+  if (state_ == InKey) {
+    rapidjson::ParseResult result;
+    KeyHandler key;
+    {
+      // The arena is released before the callback, which may parse with it.
+      ParseArena arena;
+      rapidjson::MemoryStream ms(token, length);
+      rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> is(ms);
+      result = arena.reader().Parse(is, key);
+    }
+    if (result.IsError()) {
+      syntaxError(result.Code(), token_offset_ + result.Offset());
+      return;
+    }
+    key_ = std::move(key.key);
+    state_ = AfterKey;
+    if (on_key_) {
+      on_key_(key_);
+    }
+    return;
+  }
+
+  state_ = AfterElement;
+  if (auto status = on_element_(key_, token, length); !status.ok()) {
+    fail(status);
+  }
+}
+
+void IncrementalParser::endList() {
+  state_ = object_ ? AfterMember : AfterList;
+}
+
+bool IncrementalParser::fail(const Status& status) {
+  status_ = status;
+  state_ = Failed;
+  return false;
+}
+
+bool IncrementalParser::syntaxError(const rapidjson::ParseErrorCode code, const size_t offset) {
+  std::ostringstream ss;
+  ss << "Received parse error when deserializing JSON at offset " << offset << ": "
+     << rapidjson::GetParseError_En(code);
+  return fail(Status(1, ss.str()));
+}
+} // namespace alpaca
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "alpaca/status.h"
+#include "rapidjson/error/error.h"
+
+namespace alpaca {
+
+/**
+ * @brief Parses a JSON list while its body is still arriving.
+ *
+ * Chunks of the body are passed to feed() as they are received, and are
+ * parsed right away on the same thread. The parser only tracks the structure
+ * around the elements of the list, so it can stop at the end of any chunk and
+ * resume with the next one. Each element is handed to a callback as soon as
+ * its closing bracket is read, so model objects are built while the rest of
+ * the body is in transit and neither the full body nor a DOM of it is ever
+ * held in memory.
+ *
+ * Elements are handed over as the JSON text they are in the body. The parser
+ * only follows strings and brackets to find where an element ends, so the
+ * callback's parse of the element, such as a model's fromJSON(), is the one
+ * pass which reads and checks it. An element which lies within one chunk is
+ * handed over straight from that chunk, and only elements which span chunks
+ * are copied.
+ *
+ * The list is either a top-level array, or a top-level object whose members
+ * are arrays (such as bars keyed by symbol), in which case the elements of
+ * each array are handed over along with the member's key.
+ *
+ * @code{.cpp}
+ *   std::vector<alpaca::Asset> assets;
+ *   alpaca::IncrementalParser parser([&](const std::string&, const char* json, size_t length) {
+ *     alpaca::Asset asset;
+ *     auto status = asset.fromJSON(json, length);
+ *     assets.push_back(asset);
+ *     return status;
+ *   });
+ *   client.Get("/v2/assets", [&](const char* data, size_t length) {
+ *     return parser.feed(data, length);
+ *   });
+ *   auto status = parser.finish();
+ * @endcode
+ */
+class IncrementalParser {
+ public:
+  /**
+   * @brief Receives the key of the enclosing member (empty for a top-level
+   * array) and the JSON of an element, which is only valid during the call.
+   * Returning an error stops parsing.
+   */
+  using ElementCallback = std::function<Status(const std::string& key, const char* json, size_t length)>;
+
+  /**
+   * @brief Receives the key of every member of a top-level object, including
+   * those whose arrays are empty.
+   */
+  using KeyCallback = std::function<void(const std::string& key)>;
+
+  /**
+   * @brief The callbacks are called on the thread which calls feed().
+   */
+  explicit IncrementalParser(ElementCallback on_element, KeyCallback on_key = nullptr);
+
+  IncrementalParser(const IncrementalParser&) = delete;
+  IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+  /**
+   * @brief Parse the next chunk of the body, handing over every element which
+   * it completes.
+   *
+   * @return false once parsing has failed, after which chunks are ignored.
+   */
+  bool feed(const char* data, size_t length);
+
+  /**
+   * @brief Mark the end of the body.
+   *
+   * @return a Status indicating whether the body was a valid list and every
+   * element callback succeeded.
+   */
+  Status finish();
+
+ private:
+  /// Where the parser is in the structure around the elements
+  enum State {
+    BeforeList,
+    BeforeKey,
+    InKey,
+    AfterKey,
+    BeforeMemberList,
+    BeforeElement,
+    InElement,
+    AfterElement,
+    AfterMember,
+    AfterList,
+    Failed,
+  };
+
+  /**
+   * @brief Advance the parser by one character around the elements.
+   *
+   * @return false if the character starts a key or element and still has to
+   * be read as part of it.
+   */
+  bool step(const char c);
+
+  /**
+   * @brief Read as much of the key or element being read as a chunk holds,
+   * handing it over if it ends in the chunk.
+   *
+   * @return the number of characters which belong to the key or element.
+   */
+  size_t readToken(const char* data, const size_t length);
+
+  void startToken();
+
+  /**
+   * @brief Hand over a key or element.
+   */
+  void endToken(const char* token, const size_t length);
+
+  void endList();
+
+  bool fail(const Status& status);
+
+  /**
+   * @brief Fail with a rapidjson error at an offset of the body.
+   */
+  bool syntaxError(const rapidjson::ParseErrorCode code, const size_t offset);
+
+ private:
+  ElementCallback on_element_;
+  KeyCallback on_key_;
+
+  State state_ = BeforeList;
+  /// Whether the list is a top-level object of arrays
+  bool object_ = false;
+  /// Whether the next element or member would be the first of its container
+  bool first_ = true;
+  std::string key_;
+
+  /// The part of the key or element being read which came in earlier chunks.
+  /// It starts at token_offset_.
+  std::string token_;
+  size_t token_offset_ = 0;
+  /// The number of containers open in token_
+  size_t depth_ = 0;
+  bool in_string_ = false;
+  bool escaped_ = false;
+
+  /// The offset of the next character of the body
+  size_t offset_ = 0;
+  Status status_;
+};
+} // namespace alpaca
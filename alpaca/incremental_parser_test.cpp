@@ -0,0 +1,148 @@
+#include "alpaca/incremental_parser.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class IncrementalParserTest : public ::testing::Test {};
+
+namespace {
+/// Feeds a body to a parser a few bytes at a time
+alpaca::Status parseInChunks(alpaca::IncrementalParser& parser, const std::string& body, size_t chunk_size) {
+  for (size_t i = 0; i < body.size(); i += chunk_size) {
+    parser.feed(body.data() + i, std::min(chunk_size, body.size() - i));
+  }
+  return parser.finish();
+}
+} // namespace
+
+TEST_F(IncrementalParserTest, testArray) {
+  std::vector<std::string> elements;
+  alpaca::IncrementalParser parser([&](const std::string& key, const char* json, size_t length) {
+    EXPECT_EQ(key, "");
+    elements.emplace_back(json, length);
+    return alpaca::Status();
+  });
+  auto status = parseInChunks(parser, "[{\"symbol\": \"AAPL\", \"tradable\": true}, {\"symbol\": \"TSLA\"}, 3]", 1);
+  EXPECT_OK(status);
+  ASSERT_EQ(elements.size(), 3);
+  EXPECT_EQ(elements[0], "{\"symbol\": \"AAPL\", \"tradable\": true}");
+  EXPECT_EQ(elements[1], "{\"symbol\": \"TSLA\"}");
+  EXPECT_EQ(elements[2], "3");
+}
+
+TEST_F(IncrementalParserTest, testObjectOfArrays) {
+  std::vector<std::pair<std::string, std::string>> elements;
+  std::vector<std::string> keys;
+  alpaca::IncrementalParser parser(
+      [&](const std::string& key, const char* json, size_t length) {
+        elements.emplace_back(key, std::string(json, length));
+        return alpaca::Status();
+      },
+      [&](const std::string& key) { keys.push_back(key); });
+  auto status = parseInChunks(parser, "{\"AAPL\": [{\"t\": 1}, {\"t\": 2}], \"TSLA\": [], \"SPY\": [{\"t\": 3}]}", 7);
+  EXPECT_OK(status);
+  EXPECT_EQ(keys, std::vector<std::string>({"AAPL", "TSLA", "SPY"}));
+  ASSERT_EQ(elements.size(), 3);
+  EXPECT_EQ(elements[0], std::make_pair(std::string("AAPL"), std::string("{\"t\": 1}")));
+  EXPECT_EQ(elements[1], std::make_pair(std::string("AAPL"), std::string("{\"t\": 2}")));
+  EXPECT_EQ(elements[2], std::make_pair(std::string("SPY"), std::string("{\"t\": 3}")));
+}
+
+TEST_F(IncrementalParserTest, testBracketsInStrings) {
+  std::vector<std::string> elements;
+  alpaca::IncrementalParser parser([&](const std::string&, const char* json, size_t length) {
+    elements.emplace_back(json, length);
+    return alpaca::Status();
+  });
+  auto status = parseInChunks(parser, "[{\"s\": \"]}[\"}, \"\\\"],\", true]", 1);
+  EXPECT_OK(status);
+  ASSERT_EQ(elements.size(), 3);
+  EXPECT_EQ(elements[0], "{\"s\": \"]}[\"}");
+  EXPECT_EQ(elements[2], "true");
+}
+
+TEST_F(IncrementalParserTest, testMalformed) {
+  alpaca::IncrementalParser truncated([](const std::string&, const char*, size_t) { return alpaca::Status(); });
+  EXPECT_NOT_OK(parseInChunks(truncated, "[{\"symbol\": \"AAPL\"}, {\"sym", 4));
+
+  alpaca::IncrementalParser empty([](const std::string&, const char*, size_t) { return alpaca::Status(); });
+  EXPECT_NOT_OK(empty.finish());
+
+  alpaca::IncrementalParser scalar([](const std::string&, const char*, size_t) { return alpaca::Status(); });
+  EXPECT_NOT_OK(parseInChunks(scalar, "42", 4));
+
+  alpaca::IncrementalParser nested([](const std::string&, const char*, size_t) { return alpaca::Status(); });
+  EXPECT_NOT_OK(parseInChunks(nested, "{\"code\": 40010000, \"message\": \"error\"}", 4));
+
+  alpaca::IncrementalParser missing([](const std::string&, const char*, size_t) { return alpaca::Status(); });
+  EXPECT_NOT_OK(parseInChunks(missing, "[1, , 2]", 3));
+}
+
+TEST_F(IncrementalParserTest, testElementsAreNotCopiedWithinChunks) {
+  const std::string first = "[{\"a\": 1}, {\"b\": ";
+  const std::string second = "2}, 3]";
+  std::vector<std::string> elements;
+  std::vector<bool> in_chunk;
+  const std::string* chunk = nullptr;
+  alpaca::IncrementalParser parser([&](const std::string&, const char* json, size_t length) {
+    elements.emplace_back(json, length);
+    in_chunk.push_back(json >= chunk->data() && json + length <= chunk->data() + chunk->size());
+    return alpaca::Status();
+  });
+  chunk = &first;
+  EXPECT_TRUE(parser.feed(first.data(), first.size()));
+  chunk = &second;
+  EXPECT_TRUE(parser.feed(second.data(), second.size()));
+  EXPECT_OK(parser.finish());
+  EXPECT_EQ(elements, std::vector<std::string>({"{\"a\": 1}", "{\"b\": 2}", "3"}));
+  // Only the element which spans both chunks is copied.
+  EXPECT_EQ(in_chunk, std::vector<bool>({true, false, true}));
+}
+
+TEST_F(IncrementalParserTest, testCallbackError) {
+  size_t calls = 0;
+  alpaca::IncrementalParser parser([&](const std::string&, const char*, size_t) {
+    ++calls;
+    return alpaca::Status(1, "Bad element");
+  });
+  auto status = parseInChunks(parser, "[1, 2, 3]", 2);
+  EXPECT_NOT_OK(status);
+  EXPECT_EQ(status.getMessage(), "Bad element");
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_F(IncrementalParserTest, testFeedStopsAfterFailure) {
+  alpaca::IncrementalParser parser([](const std::string&, const char*, size_t) { return alpaca::Status(); });
+  EXPECT_TRUE(parser.feed("[1, ", 4));
+  EXPECT_FALSE(parser.feed("}", 1));
+  EXPECT_FALSE(parser.feed("2]", 2));
+  EXPECT_NOT_OK(parser.finish());
+}
+
+TEST_F(IncrementalParserTest, testParsesOnFeedingThread) {
+  std::vector<std::thread::id> threads;
+  alpaca::IncrementalParser parser([&](const std::string&, const char*, size_t) {
+    threads.push_back(std::this_thread::get_id());
+    return alpaca::Status();
+  });
+  // Each element is handed over by the feed which completes it.
+  EXPECT_TRUE(parser.feed("[{\"a\": ", 7));
+  EXPECT_TRUE(threads.empty());
+  EXPECT_TRUE(parser.feed("1}, ", 4));
+  EXPECT_EQ(threads, std::vector<std::thread::id>({std::this_thread::get_id()}));
+  EXPECT_TRUE(parser.feed("\"x\"]", 4));
+  EXPECT_EQ(threads.size(), 2);
+  EXPECT_OK(parser.finish());
+}
+
+TEST_F(IncrementalParserTest, testAbandoned) {
+  // A parser whose body never finished can be destroyed without finishing.
+  alpaca::IncrementalParser parser([](const std::string&, const char*, size_t) { return alpaca::Status(); });
+  parser.feed("[1, 2", 5);
+}
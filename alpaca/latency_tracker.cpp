@@ -0,0 +1,40 @@
+#include "alpaca/latency_tracker.h"
+
+#include <algorithm>
+
+namespace alpaca {
+
+LatencyTracker::LatencyTracker(size_t window) : window_(window > 0 ? window : 1) {
+  latencies_.reserve(window_);
+}
+
+void LatencyTracker::record(const std::chrono::microseconds latency) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (latencies_.size() < window_) {
+    latencies_.push_back(latency.count());
+  } else {
+    latencies_[next_] = latency.count();
+  }
+  next_ = (next_ + 1) % window_;
+}
+
+std::chrono::microseconds LatencyTracker::percentile(const double p) const {
+  std::vector<int64_t> latencies;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latencies = latencies_;
+  }
+  if (latencies.empty()) {
+    return std::chrono::microseconds(0);
+  }
+
+  auto rank = static_cast<size_t>(std::clamp(p, 0.0, 1.0) * (latencies.size() - 1));
+  std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+  return std::chrono::microseconds(latencies[rank]);
+}
+
+size_t LatencyTracker::samples() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return latencies_.size();
+}
+} // namespace alpaca
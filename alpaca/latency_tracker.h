@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace alpaca {
+
+/**
+ * @brief Keeps a sliding window of request latencies and reports percentiles.
+ *
+ * @code{.cpp}
+ *   auto tracker = alpaca::LatencyTracker(256);
+ *   tracker.record(std::chrono::milliseconds(12));
+ *   auto p95 = tracker.percentile(0.95);
+ * @endcode
+ */
+class LatencyTracker {
+ public:
+  /**
+   * @brief The primary constructor.
+   *
+   * @param window The number of most recent latencies which are kept.
+   */
+  explicit LatencyTracker(size_t window);
+
+  /**
+   * @brief The default constructor of LatencyTracker should never be used.
+   */
+  explicit LatencyTracker() = delete;
+
+  LatencyTracker(const LatencyTracker&) = delete;
+  LatencyTracker& operator=(const LatencyTracker&) = delete;
+
+  /**
+   * @brief Record the latency of a completed request.
+   */
+  void record(const std::chrono::microseconds latency);
+
+  /**
+   * @brief The given percentile, between 0 and 1, of the recorded latencies.
+   *
+   * @return the percentile, or zero if nothing has been recorded yet.
+   */
+  std::chrono::microseconds percentile(const double p) const;
+
+  /**
+   * @brief The number of latencies currently in the window.
+   */
+  size_t samples() const;
+
+ private:
+  size_t window_;
+  size_t next_ = 0;
+  std::vector<int64_t> latencies_;
+  mutable std::mutex mutex_;
+};
+} // namespace alpaca
@@ -0,0 +1,36 @@
+#include "alpaca/latency_tracker.h"
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class LatencyTrackerTest : public ::testing::Test {};
+
+TEST_F(LatencyTrackerTest, testEmpty) {
+  alpaca::LatencyTracker tracker(16);
+  EXPECT_EQ(tracker.samples(), 0);
+  EXPECT_EQ(tracker.percentile(0.95).count(), 0);
+}
+
+TEST_F(LatencyTrackerTest, testPercentile) {
+  alpaca::LatencyTracker tracker(100);
+  for (int i = 100; i >= 1; --i) {
+    tracker.record(std::chrono::microseconds(i));
+  }
+  EXPECT_EQ(tracker.samples(), 100);
+  EXPECT_EQ(tracker.percentile(0).count(), 1);
+  EXPECT_EQ(tracker.percentile(0.5).count(), 50);
+  EXPECT_EQ(tracker.percentile(0.95).count(), 95);
+  EXPECT_EQ(tracker.percentile(1).count(), 100);
+}
+
+TEST_F(LatencyTrackerTest, testWindow) {
+  alpaca::LatencyTracker tracker(4);
+  for (int i = 0; i < 4; ++i) {
+    tracker.record(std::chrono::microseconds(1000));
+  }
+  for (int i = 0; i < 4; ++i) {
+    tracker.record(std::chrono::microseconds(10));
+  }
+  EXPECT_EQ(tracker.samples(), 4);
+  EXPECT_EQ(tracker.percentile(1).count(), 10);
+}
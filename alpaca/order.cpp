@@ -1,10 +1,41 @@
 #include "alpaca/order.h"
 
-#include "alpaca/json.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
 
 namespace alpaca {
 
+namespace {
+constexpr auto kOrderSchema = makeSchema<Order>("an order",
+    {
+        {"asset_class", &parseEnum<&Order::asset_class>},
+        {"asset_id", &Order::asset_id},
+        {"canceled_at", &Order::canceled_at},
+        {"client_order_id", &Order::client_order_id},
+        {"created_at", &Order::created_at},
+        {"expired_at", &Order::expired_at},
+        {"extended_hours", &Order::extended_hours},
+        {"failed_at", &Order::failed_at},
+        {"filled_at", &Order::filled_at},
+        {"filled_avg_price", &Order::filled_avg_price},
+        {"filled_qty", &Order::filled_qty},
+        {"id", &Order::id},
+        {"legs", &Order::legs},
+        {"limit_price", &Order::limit_price},
+        {"qty", &Order::qty},
+        {"side", &parseEnum<&Order::side>},
+        {"status", &parseEnum<&Order::status>},
+        {"stop_price", &Order::stop_price},
+        {"submitted_at", &Order::submitted_at},
+        {"symbol", &Order::symbol},
+        {"time_in_force", &parseEnum<&Order::time_in_force>},
+        {"type", &parseEnum<&Order::type>},
+        {"updated_at", &Order::updated_at},
+    });
+} // namespace
+
 std::string orderDirectionToString(const OrderDirection direction) {
   switch (direction) {
   case OrderDirection::Ascending:
@@ -15,42 +46,15 @@ std::string orderDirectionToString(const OrderDirection direction) {
 }
 
 std::string orderSideToString(const OrderSide side) {
-  switch (side) {
-  case OrderSide::Buy:
-    return "buy";
-  case OrderSide::Sell:
-    return "sell";
-  }
+  return Enum<OrderSide>(side).toString();
 }
 
 std::string orderTypeToString(const OrderType type) {
-  switch (type) {
-  case OrderType::Market:
-    return "market";
-  case OrderType::Limit:
-    return "limit";
-  case OrderType::Stop:
-    return "stop";
-  case OrderType::StopLimit:
-    return "stop_limit";
-  }
+  return Enum<OrderType>(type).toString();
 }
 
 std::string orderTimeInForceToString(const OrderTimeInForce tif) {
-  switch (tif) {
-  case OrderTimeInForce::Day:
-    return "day";
-  case OrderTimeInForce::GoodUntilCanceled:
-    return "gtc";
-  case OrderTimeInForce::OPG:
-    return "opg";
-  case OrderTimeInForce::CLS:
-    return "cls";
-  case OrderTimeInForce::ImmediateOrCancel:
-    return "ioc";
-  case OrderTimeInForce::FillOrKill:
-    return "fok";
-  }
+  return Enum<OrderTimeInForce>(tif).toString();
 }
 
 std::string orderClassToString(const OrderClass order_class) {
@@ -66,40 +70,89 @@ std::string orderClassToString(const OrderClass order_class) {
   }
 }
 
-Status Order::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing order JSON");
+std::string OrderRequest::toJSON() const {
+  rapidjson::StringBuffer s;
+  s.Clear();
+  rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+  writer.StartObject();
+
+  writer.Key("symbol");
+  writer.String(symbol.toString().c_str());
+
+  writer.Key("qty");
+  writer.Int(quantity);
+
+  writer.Key("side");
+  writer.String(orderSideToString(side).c_str());
+
+  writer.Key("type");
+  writer.String(orderTypeToString(type).c_str());
+
+  writer.Key("time_in_force");
+  writer.String(orderTimeInForceToString(time_in_force).c_str());
+
+  if (!limit_price.empty()) {
+    writer.Key("limit_price");
+    writer.String(limit_price.toString().c_str());
+  }
+
+  if (!stop_price.empty()) {
+    writer.Key("stop_price");
+    writer.String(stop_price.toString().c_str());
+  }
+
+  if (extended_hours) {
+    writer.Key("extended_hours");
+    writer.Bool(extended_hours);
+  }
+
+  if (client_order_id != "") {
+    writer.Key("client_order_id");
+    writer.String(client_order_id.c_str());
+  }
+
+  if (order_class != OrderClass::Simple) {
+    writer.Key("order_class");
+    writer.String(orderClassToString(order_class).c_str());
+  }
+
+  if (take_profit) {
+    writer.Key("take_profit");
+    writer.StartObject();
+    if (!take_profit->limitPrice.empty()) {
+      writer.Key("limit_price");
+      writer.String(take_profit->limitPrice.toString().c_str());
+    }
+    writer.EndObject();
   }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't an order object");
+  if (stop_loss) {
+    writer.Key("stop_loss");
+    writer.StartObject();
+    if (!stop_loss->limitPrice.empty()) {
+      writer.Key("limit_price");
+      writer.String(stop_loss->limitPrice.toString().c_str());
+    }
+    if (!stop_loss->stopPrice.empty()) {
+      writer.Key("stop_price");
+      writer.String(stop_loss->stopPrice.toString().c_str());
+    }
+    writer.EndObject();
   }
 
-  PARSE_STRING(asset_class, "asset_class")
-  PARSE_STRING(asset_id, "asset_id")
-  PARSE_STRING(canceled_at, "canceled_at")
-  PARSE_STRING(client_order_id, "client_order_id")
-  PARSE_STRING(created_at, "created_at")
-  PARSE_STRING(expired_at, "expired_at")
-  PARSE_BOOL(extended_hours, "extended_hours")
-  PARSE_STRING(failed_at, "failed_at")
-  PARSE_STRING(filled_at, "filled_at")
-  PARSE_STRING(filled_avg_price, "filled_avg_price")
-  PARSE_STRING(filled_qty, "filled_qty")
-  PARSE_STRING(id, "id")
-  PARSE_BOOL(legs, "legs")
-  PARSE_STRING(limit_price, "limit_price")
-  PARSE_STRING(qty, "qty")
-  PARSE_STRING(side, "side")
-  PARSE_STRING(status, "status")
-  PARSE_STRING(stop_price, "stop_price")
-  PARSE_STRING(submitted_at, "submitted_at")
-  PARSE_STRING(symbol, "symbol")
-  PARSE_STRING(time_in_force, "time_in_force")
-  PARSE_STRING(type, "type")
-  PARSE_STRING(updated_at, "updated_at")
-
-  return Status();
+  writer.EndObject();
+  return s.GetString();
+}
+
+Status Order::fromJSON(const std::string& json) {
+  return fromJSON(json.data(), json.size());
+}
+
+Status Order::fromJSON(const char* json, const size_t length) {
+  return kOrderSchema.parse(json, length, *this);
+}
+
+Status Order::fromDocument(const rapidjson::Value& d) {
+  return kOrderSchema.read(d, *this);
 }
 } // namespace alpaca
\ No newline at end of file
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <optional>
 #include <string>
 
+#include "alpaca/asset.h"
+#include "alpaca/decimal.h"
+#include "alpaca/enum.h"
 #include "alpaca/status.h"
+#include "alpaca/symbol.h"
+#include "alpaca/timestamp.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
@@ -22,9 +29,18 @@ std::string orderDirectionToString(const OrderDirection direction);
 /**
  * @brief When you submit an order, you may be buying or selling.
  */
-enum OrderSide {
+enum class OrderSide {
   Buy,
   Sell,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<OrderSide> {
+  static constexpr EnumName<OrderSide> kNames[] = {
+      {"buy", OrderSide::Buy},
+      {"sell", OrderSide::Sell},
+  };
 };
 
 /**
@@ -38,11 +54,22 @@ std::string orderSideToString(const OrderSide side);
  * For more information on supported order types, see:
  * https://alpaca.markets/docs/trading-on-alpaca/orders/#order-types
  */
-enum OrderType {
+enum class OrderType {
   Market,
   Limit,
   Stop,
   StopLimit,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<OrderType> {
+  static constexpr EnumName<OrderType> kNames[] = {
+      {"market", OrderType::Market},
+      {"limit", OrderType::Limit},
+      {"stop", OrderType::Stop},
+      {"stop_limit", OrderType::StopLimit},
+  };
 };
 
 /**
@@ -56,13 +83,26 @@ std::string orderTypeToString(const OrderType side);
  * For more information on the supported designations, see:
  * https://alpaca.markets/docs/trading-on-alpaca/orders/#time-in-force
  */
-enum OrderTimeInForce {
+enum class OrderTimeInForce {
   Day,
   GoodUntilCanceled,
   OPG,
   CLS,
   ImmediateOrCancel,
   FillOrKill,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<OrderTimeInForce> {
+  static constexpr EnumName<OrderTimeInForce> kNames[] = {
+      {"day", OrderTimeInForce::Day},
+      {"gtc", OrderTimeInForce::GoodUntilCanceled},
+      {"opg", OrderTimeInForce::OPG},
+      {"cls", OrderTimeInForce::CLS},
+      {"ioc", OrderTimeInForce::ImmediateOrCancel},
+      {"fok", OrderTimeInForce::FillOrKill},
+  };
 };
 
 /**
@@ -70,6 +110,54 @@ enum OrderTimeInForce {
  */
 std::string orderTimeInForceToString(const OrderTimeInForce tif);
 
+/**
+ * @brief The state of an order in its lifecycle.
+ *
+ * For more information on order statuses, see:
+ * https://alpaca.markets/docs/trading-on-alpaca/orders/#order-lifecycle
+ */
+enum class OrderStatus {
+  New,
+  PartiallyFilled,
+  Filled,
+  DoneForDay,
+  Canceled,
+  Expired,
+  Replaced,
+  PendingCancel,
+  PendingReplace,
+  Accepted,
+  PendingNew,
+  AcceptedForBidding,
+  Stopped,
+  Rejected,
+  Suspended,
+  Calculated,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<OrderStatus> {
+  static constexpr EnumName<OrderStatus> kNames[] = {
+      {"new", OrderStatus::New},
+      {"partially_filled", OrderStatus::PartiallyFilled},
+      {"filled", OrderStatus::Filled},
+      {"done_for_day", OrderStatus::DoneForDay},
+      {"canceled", OrderStatus::Canceled},
+      {"expired", OrderStatus::Expired},
+      {"replaced", OrderStatus::Replaced},
+      {"pending_cancel", OrderStatus::PendingCancel},
+      {"pending_replace", OrderStatus::PendingReplace},
+      {"accepted", OrderStatus::Accepted},
+      {"pending_new", OrderStatus::PendingNew},
+      {"accepted_for_bidding", OrderStatus::AcceptedForBidding},
+      {"stopped", OrderStatus::Stopped},
+      {"rejected", OrderStatus::Rejected},
+      {"suspended", OrderStatus::Suspended},
+      {"calculated", OrderStatus::Calculated},
+  };
+};
+
 /**
  * @brief The class of the order
  *
@@ -93,7 +181,7 @@ std::string orderClassToString(const OrderClass order_class);
  */
 struct TakeProfitParams {
   /// Required for bracket orders
-  std::string limitPrice;
+  Decimal limitPrice;
 };
 
 /**
@@ -101,9 +189,42 @@ struct TakeProfitParams {
  */
 struct StopLossParams {
   /// Required for bracket orders
-  std::string stopPrice;
+  Decimal stopPrice;
   /// The stop-loss order becomes a stop-limit order if specified
-  std::string limitPrice;
+  Decimal limitPrice;
+};
+
+/**
+ * @brief The parameters of a new Alpaca order.
+ *
+ * @code{.cpp}
+ *   auto request = alpaca::OrderRequest();
+ *   request.symbol = "NFLX";
+ *   request.quantity = 10;
+ *   request.side = alpaca::OrderSide::Buy;
+ *   request.type = alpaca::OrderType::Limit;
+ *   request.limit_price = alpaca::Decimal("350.00");
+ *   auto resp = client.submitOrder(request);
+ * @endcode
+ */
+struct OrderRequest {
+  /**
+   * @brief Serialize the request into the JSON body accepted by the API.
+   */
+  std::string toJSON() const;
+
+  SymbolId symbol;
+  int quantity = 0;
+  OrderSide side = OrderSide::Buy;
+  OrderType type = OrderType::Market;
+  OrderTimeInForce time_in_force = OrderTimeInForce::Day;
+  Decimal limit_price;
+  Decimal stop_price;
+  bool extended_hours = false;
+  std::string client_order_id;
+  OrderClass order_class = OrderClass::Simple;
+  std::optional<TakeProfitParams> take_profit;
+  std::optional<StopLossParams> stop_loss;
 };
 
 /**
@@ -120,29 +241,50 @@ class Order {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing JSON which needn't be null terminated,
+   * such as an element of a streamed list, into the current object state.
+   *
+   * @param json The JSON characters
+   * @param length The number of characters
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromJSON(const char* json, const size_t length);
+
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
-  std::string asset_class;
+  Enum<AssetClass> asset_class;
   std::string asset_id;
-  std::string canceled_at;
+  Timestamp canceled_at;
   std::string client_order_id;
-  std::string created_at;
-  std::string expired_at;
+  Timestamp created_at;
+  Timestamp expired_at;
   bool extended_hours;
-  std::string failed_at;
-  std::string filled_at;
-  std::string filled_avg_price;
-  std::string filled_qty;
+  Timestamp failed_at;
+  Timestamp filled_at;
+  Decimal filled_avg_price;
+  Decimal filled_qty;
   std::string id;
   bool legs;
-  std::string limit_price;
-  std::string qty;
-  std::string side;
-  std::string status;
-  std::string stop_price;
-  std::string submitted_at;
-  std::string symbol;
-  std::string time_in_force;
-  std::string type;
-  std::string updated_at;
+  Decimal limit_price;
+  Decimal qty;
+  Enum<OrderSide> side;
+  Enum<OrderStatus> status;
+  Decimal stop_price;
+  Timestamp submitted_at;
+  SymbolId symbol;
+  Enum<OrderTimeInForce> time_in_force;
+  Enum<OrderType> type;
+  Timestamp updated_at;
 };
 } // namespace alpaca
\ No newline at end of file
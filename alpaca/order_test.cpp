@@ -3,6 +3,7 @@
 #include "alpaca/testing.h"
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "rapidjson/document.h"
 
 class OrderTest : public ::testing::Test {};
 
@@ -37,4 +38,53 @@ TEST_F(OrderTest, testOrderFromJSON) {
   alpaca::Order order;
   EXPECT_OK(order.fromJSON(kOrderJSON));
   EXPECT_EQ(order.symbol, "AAPL");
+  EXPECT_EQ(order.qty, alpaca::Decimal("15"));
+  EXPECT_EQ(order.limit_price.toString(), "107.00");
+  EXPECT_LT(order.filled_avg_price, order.limit_price);
+  EXPECT_EQ(order.submitted_at.toString(), "2018-10-05T05:48:59Z");
+  EXPECT_EQ(order.submitted_at, order.filled_at);
+  EXPECT_EQ(order.side, alpaca::OrderSide::Buy);
+  EXPECT_EQ(order.status, alpaca::OrderStatus::Accepted);
+  EXPECT_EQ(order.type, alpaca::OrderType::Market);
+  EXPECT_EQ(order.time_in_force, alpaca::OrderTimeInForce::Day);
+  EXPECT_EQ(order.asset_class.toString(), "us_equity");
+}
+
+TEST_F(OrderTest, testOrderFromJSONInBuffer) {
+  // An element of a streamed list is read in place, followed by the rest of
+  // the body rather than a terminator.
+  auto body = "[" + kOrderJSON + ", {}]";
+  alpaca::Order order;
+  EXPECT_OK(order.fromJSON(body.data() + 1, kOrderJSON.size()));
+  EXPECT_EQ(order.symbol, "AAPL");
+  EXPECT_EQ(order.qty, alpaca::Decimal("15"));
+  EXPECT_NOT_OK(order.fromJSON(body.data() + 1, kOrderJSON.size() - 1));
+}
+
+TEST_F(OrderTest, testOrderRequestToJSON) {
+  alpaca::OrderRequest request;
+  request.symbol = "AAPL";
+  request.quantity = 15;
+  request.side = alpaca::OrderSide::Sell;
+  request.type = alpaca::OrderType::Limit;
+  request.time_in_force = alpaca::OrderTimeInForce::GoodUntilCanceled;
+  request.limit_price = alpaca::Decimal("107.00");
+  request.order_class = alpaca::OrderClass::Bracket;
+  request.take_profit = alpaca::TakeProfitParams{alpaca::Decimal("110.00")};
+  request.stop_loss = alpaca::StopLossParams{alpaca::Decimal("100.00"), alpaca::Decimal()};
+
+  rapidjson::Document d;
+  EXPECT_FALSE(d.Parse(request.toJSON().c_str()).HasParseError());
+  EXPECT_STREQ(d["symbol"].GetString(), "AAPL");
+  EXPECT_EQ(d["qty"].GetInt(), 15);
+  EXPECT_STREQ(d["side"].GetString(), "sell");
+  EXPECT_STREQ(d["type"].GetString(), "limit");
+  EXPECT_STREQ(d["time_in_force"].GetString(), "gtc");
+  EXPECT_STREQ(d["limit_price"].GetString(), "107.00");
+  EXPECT_FALSE(d.HasMember("stop_price"));
+  EXPECT_FALSE(d.HasMember("client_order_id"));
+  EXPECT_STREQ(d["order_class"].GetString(), "bracket");
+  EXPECT_STREQ(d["take_profit"]["limit_price"].GetString(), "110.00");
+  EXPECT_STREQ(d["stop_loss"]["stop_price"].GetString(), "100.00");
+  EXPECT_FALSE(d["stop_loss"].HasMember("limit_price"));
 }
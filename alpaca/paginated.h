@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "alpaca/status.h"
+
+namespace alpaca {
+
+/**
+ * @brief A lazily fetched, single-pass range over every item of a paginated
+ * endpoint.
+ *
+ * Pages are fetched as the range is iterated. As soon as a page arrives the
+ * next one is requested in the background, so fetching overlaps with the
+ * caller's processing of the current page. Iteration stops at the first
+ * error, which is then reported by status().
+ *
+ * @code{.cpp}
+ *   auto orders = client.iterateOrders(alpaca::ActionStatus::All);
+ *   for (const auto& order : orders) {
+ *     LOG(INFO) << order.id;
+ *   }
+ *   if (!orders.status().ok()) {
+ *     LOG(ERROR) << "Error listing orders: " << orders.status().getMessage();
+ *   }
+ * @endcode
+ */
+template <typename T>
+class Paginated {
+  struct State;
+
+ public:
+  /**
+   * @brief Fetches the page which follows an item, or the first page when the
+   * item is null.
+   */
+  using FetchPage = std::function<std::pair<Status, std::vector<T>>(const T* last)>;
+
+  /**
+   * @param fetch Fetches pages; it is called on a background thread for every
+   * page but the first.
+   * @param page_size The number of items requested per page. A shorter page is
+   * taken to be the last one.
+   */
+  Paginated(FetchPage fetch, const size_t page_size) : state_(std::make_shared<State>()) {
+    state_->fetch = std::move(fetch);
+    state_->page_size = page_size;
+  }
+
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    iterator() = default;
+
+    reference operator*() const {
+      return state_->page[state_->index];
+    }
+
+    pointer operator->() const {
+      return &state_->page[state_->index];
+    }
+
+    iterator& operator++() {
+      state_->advance();
+      if (state_->done) {
+        state_ = nullptr;
+      }
+      return *this;
+    }
+
+    bool operator==(const iterator& other) const {
+      return state_ == other.state_;
+    }
+
+    bool operator!=(const iterator& other) const {
+      return state_ != other.state_;
+    }
+
+   private:
+    friend class Paginated;
+    explicit iterator(State* state) : state_(state) {}
+
+    State* state_ = nullptr;
+  };
+
+  /**
+   * @brief The current position of the range, fetching the first page if it
+   * has not been fetched yet.
+   */
+  iterator begin() {
+    if (!state_->started) {
+      state_->started = true;
+      state_->load(state_->fetch(nullptr));
+    }
+    return state_->done ? end() : iterator(state_.get());
+  }
+
+  iterator end() {
+    return iterator();
+  }
+
+  /**
+   * @brief The error which ended iteration early, if any.
+   */
+  const Status& status() const {
+    return state_->status;
+  }
+
+ private:
+  struct State {
+    FetchPage fetch;
+    size_t page_size = 0;
+    std::vector<T> page;
+    size_t index = 0;
+    std::future<std::pair<Status, std::vector<T>>> next;
+    bool started = false;
+    bool last_page = false;
+    bool done = false;
+    Status status;
+
+    void advance() {
+      if (++index < page.size()) {
+        return;
+      }
+      if (last_page) {
+        done = true;
+        return;
+      }
+      load(next.get());
+    }
+
+    void load(std::pair<Status, std::vector<T>> result) {
+      index = 0;
+      page = std::move(result.second);
+      if (!result.first.ok()) {
+        status = result.first;
+        done = true;
+        return;
+      }
+      if (page.empty()) {
+        done = true;
+        return;
+      }
+      last_page = page.size() < page_size;
+      if (!last_page) {
+        // The prefetch runs on its own thread rather than the client's I/O
+        // executor, so that iterating from an I/O thread cannot deadlock.
+        // The task owns copies of everything it uses, but the future blocks
+        // when it is destroyed, so abandoning a range waits for the prefetch.
+        next = std::async(std::launch::async, [fetch = fetch, last = page.back()]() { return fetch(&last); });
+      }
+    }
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Fetch the pages of an endpoint which is paged by moving a time bound
+ * to the time of the last item of the previous page.
+ *
+ * fetch(bound) returns the page which starts at bound, including the items at
+ * bound itself, or the first page when bound is null. Since the items which
+ * share the boundary time may be split across two pages, those which were
+ * already returned are dropped from the next page.
+ *
+ * @code{.cpp}
+ *   auto time = [](const alpaca::Order& order) { return order.submitted_at; };
+ *   auto id = [](const alpaca::Order& order) { return order.id; };
+ *   alpaca::Paginated<alpaca::Order> orders(
+ *       alpaca::pageByTime<alpaca::Order, alpaca::Timestamp, std::string>(fetch, time, id, 500), 500);
+ * @endcode
+ *
+ * @return a FetchPage which fails if a whole page of items share one time,
+ * since they cannot be paged past.
+ */
+template <typename T, typename Time, typename Id>
+typename Paginated<T>::FetchPage pageByTime(std::function<std::pair<Status, std::vector<T>>(const Time* bound)> fetch,
+                                            std::function<Time(const T&)> time_of,
+                                            std::function<Id(const T&)> id_of,
+                                            const size_t page_size) {
+  // The items returned so far at the time of the last item. Pages are
+  // fetched one after another, so this is never accessed concurrently.
+  struct Boundary {
+    Time time;
+    std::unordered_set<Id> ids;
+  };
+  auto boundary = std::make_shared<Boundary>();
+  auto remember = [boundary, time_of, id_of](const std::vector<T>& page) {
+    if (page.empty()) {
+      return;
+    }
+    auto time = time_of(page.back());
+    if (!(time == boundary->time)) {
+      boundary->time = time;
+      boundary->ids.clear();
+    }
+    for (const auto& item : page) {
+      if (time_of(item) == time) {
+        boundary->ids.insert(id_of(item));
+      }
+    }
+  };
+
+  return [fetch, time_of, id_of, page_size, boundary, remember](const T* last) {
+    if (last == nullptr) {
+      auto result = fetch(nullptr);
+      remember(result.second);
+      return result;
+    }
+
+    // Fetch until a whole page of new items has been found, so that the
+    // dropped items do not make a page look like the last one.
+    std::vector<T> items;
+    while (items.size() < page_size) {
+      auto bound = boundary->time;
+      auto result = fetch(&bound);
+      if (!result.first.ok()) {
+        return std::make_pair(result.first, std::move(items));
+      }
+      auto& page = result.second;
+      auto last_page = page.size() < page_size;
+      if (!last_page && time_of(page.back()) == bound) {
+        return std::make_pair(Status(1, "A whole page of items share the same time"), std::move(items));
+      }
+      for (auto& item : page) {
+        if (!(time_of(item) == bound) || boundary->ids.count(id_of(item)) == 0) {
+          items.push_back(std::move(item));
+        }
+      }
+      remember(items);
+      if (last_page) {
+        break;
+      }
+    }
+    return std::make_pair(Status(), std::move(items));
+  };
+}
+} // namespace alpaca
@@ -0,0 +1,136 @@
+#include "alpaca/paginated.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class PaginatedTest : public ::testing::Test {};
+
+namespace {
+/// Pages through the integers [0, count) page_size at a time
+alpaca::Paginated<int>::FetchPage countTo(int count, size_t page_size, std::atomic<int>& fetches) {
+  return [count, page_size, &fetches](const int* last) {
+    ++fetches;
+    std::vector<int> page;
+    for (int i = last == nullptr ? 0 : *last + 1; i < count && page.size() < page_size; ++i) {
+      page.push_back(i);
+    }
+    return std::make_pair(alpaca::Status(), page);
+  };
+}
+
+struct Event {
+  int time;
+  int id;
+};
+
+/// Pages through events which are sorted by time, starting at a bound
+alpaca::Paginated<Event>::FetchPage eventsFrom(const std::vector<Event>& events, size_t page_size) {
+  auto fetch = [events, page_size](const int* bound) {
+    std::vector<Event> page;
+    for (const auto& event : events) {
+      if ((bound == nullptr || event.time >= *bound) && page.size() < page_size) {
+        page.push_back(event);
+      }
+    }
+    return std::make_pair(alpaca::Status(), page);
+  };
+  auto time = [](const Event& event) { return event.time; };
+  auto id = [](const Event& event) { return event.id; };
+  return alpaca::pageByTime<Event, int, int>(fetch, time, id, page_size);
+}
+} // namespace
+
+TEST_F(PaginatedTest, testIteratesEveryPage) {
+  std::atomic<int> fetches{0};
+  alpaca::Paginated<int> range(countTo(10, 3, fetches), 3);
+  EXPECT_EQ(fetches, 0);
+
+  std::vector<int> items;
+  for (auto i : range) {
+    items.push_back(i);
+  }
+  EXPECT_TRUE(range.status().ok());
+  ASSERT_EQ(items.size(), 10);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(items[i], i);
+  }
+  EXPECT_EQ(fetches, 4);
+}
+
+TEST_F(PaginatedTest, testFullLastPage) {
+  std::atomic<int> fetches{0};
+  alpaca::Paginated<int> range(countTo(6, 3, fetches), 3);
+  size_t items = 0;
+  for (auto it = range.begin(); it != range.end(); ++it) {
+    ++items;
+  }
+  EXPECT_EQ(items, 6);
+  // The third, empty page is needed to find out that the second was the last.
+  EXPECT_EQ(fetches, 3);
+}
+
+TEST_F(PaginatedTest, testEmpty) {
+  std::atomic<int> fetches{0};
+  alpaca::Paginated<int> range(countTo(0, 3, fetches), 3);
+  EXPECT_EQ(range.begin(), range.end());
+  EXPECT_TRUE(range.status().ok());
+}
+
+TEST_F(PaginatedTest, testPrefetchesNextPage) {
+  std::atomic<int> fetches{0};
+  alpaca::Paginated<int> range(countTo(10, 3, fetches), 3);
+  auto it = range.begin();
+  EXPECT_EQ(*it, 0);
+  // The second page is requested without advancing past the first.
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (fetches < 2 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(fetches, 2);
+}
+
+TEST_F(PaginatedTest, testStopsAtError) {
+  alpaca::Paginated<int> range(
+      [](const int* last) {
+        if (last != nullptr) {
+          return std::make_pair(alpaca::Status(1, "HTTP 500"), std::vector<int>());
+        }
+        return std::make_pair(alpaca::Status(), std::vector<int>{1, 2});
+      },
+      2);
+  std::vector<int> items;
+  for (auto i : range) {
+    items.push_back(i);
+  }
+  EXPECT_EQ(items, std::vector<int>({1, 2}));
+  EXPECT_FALSE(range.status().ok());
+  EXPECT_EQ(range.status().getMessage(), "HTTP 500");
+}
+
+TEST_F(PaginatedTest, testPageByTime) {
+  // Several events share the times at which pages end.
+  std::vector<Event> events = {{1, 0}, {2, 1}, {2, 2}, {3, 3}, {3, 4}, {4, 5}, {4, 6}, {5, 7}};
+  alpaca::Paginated<Event> range(eventsFrom(events, 3), 3);
+  std::vector<int> ids;
+  for (const auto& event : range) {
+    ids.push_back(event.id);
+  }
+  EXPECT_TRUE(range.status().ok()) << range.status().getMessage();
+  EXPECT_EQ(ids, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST_F(PaginatedTest, testPageByTimeTooManyAtOnce) {
+  std::vector<Event> events = {{1, 0}, {1, 1}, {1, 2}, {2, 3}};
+  alpaca::Paginated<Event> range(eventsFrom(events, 2), 2);
+  std::vector<int> ids;
+  for (const auto& event : range) {
+    ids.push_back(event.id);
+  }
+  EXPECT_EQ(ids, std::vector<int>({0, 1}));
+  EXPECT_FALSE(range.status().ok());
+}
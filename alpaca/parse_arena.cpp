@@ -0,0 +1,103 @@
+#include "alpaca/parse_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace alpaca {
+
+namespace {
+/// The size of the buffer the parse stack is allocated from
+constexpr size_t kStackBytes = 16 * 1024;
+
+/// The initial capacity of the parse stack
+constexpr size_t kStackCapacity = 1024;
+
+size_t nextPowerOfTwo(const size_t n) {
+  size_t p = 1;
+  while (p < n) {
+    p *= 2;
+  }
+  return p;
+}
+} // namespace
+
+struct ParseArena::State {
+  explicit State(const size_t bytes)
+      : value_bytes(bytes),
+        value_buffer(new Chunk[(bytes + sizeof(Chunk) - 1) / sizeof(Chunk)]),
+        stack_buffer(new Chunk[kStackBytes / sizeof(Chunk)]),
+        values(value_buffer.get(), value_bytes),
+        stack(stack_buffer.get(), kStackBytes),
+        document(&values, kStackCapacity, &stack) {}
+
+  /**
+   * @brief Forget everything which was parsed while keeping the buffers.
+   */
+  void reset() {
+    document.SetNull();
+    values.Clear();
+    stack.Clear();
+  }
+
+  /// Allocated as an array of these so that the buffers are suitably aligned
+  using Chunk = std::max_align_t;
+
+  size_t value_bytes;
+  std::unique_ptr<Chunk[]> value_buffer;
+  std::unique_ptr<Chunk[]> stack_buffer;
+  rapidjson::MemoryPoolAllocator<> values;
+  rapidjson::MemoryPoolAllocator<> stack;
+  PooledDocument document;
+  rapidjson::Reader reader;
+  bool borrowed = false;
+};
+
+ParseArena::ParseArena() {
+  auto& current = threadState();
+  if (!current) {
+    current = std::make_unique<State>(kInitialBytes);
+  }
+  if (current->borrowed) {
+    temporary_ = std::make_unique<State>(kInitialBytes);
+    state_ = temporary_.get();
+  } else {
+    state_ = current.get();
+  }
+  state_->borrowed = true;
+}
+
+ParseArena::~ParseArena() {
+  if (temporary_) {
+    return;
+  }
+
+  // A parse which overflowed the value buffer spilled into chunks from the
+  // heap, which clearing frees, so grow the buffer to fit the next one.
+  auto bytes = state_->value_bytes;
+  if (state_->values.Capacity() > bytes && bytes < kMaxRetainedBytes) {
+    auto grown = std::max(2 * bytes, nextPowerOfTwo(state_->values.Size()));
+    threadState() = std::make_unique<State>(std::min(grown, kMaxRetainedBytes));
+    return;
+  }
+  state_->reset();
+  state_->borrowed = false;
+}
+
+PooledDocument& ParseArena::document() {
+  return state_->document;
+}
+
+rapidjson::Reader& ParseArena::reader() {
+  return state_->reader;
+}
+
+size_t ParseArena::retainedBytes() {
+  auto& current = threadState();
+  return current ? current->value_bytes : 0;
+}
+
+std::unique_ptr<ParseArena::State>& ParseArena::threadState() {
+  thread_local std::unique_ptr<State> state;
+  return state;
+}
+} // namespace alpaca
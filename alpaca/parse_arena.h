@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "rapidjson/document.h"
+#include "rapidjson/reader.h"
+
+namespace alpaca {
+
+/**
+ * @brief A document whose values and parse stack are both allocated from
+ * memory pools, so that clearing the pools makes it reusable.
+ */
+using PooledDocument =
+    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>, rapidjson::MemoryPoolAllocator<>>;
+
+/**
+ * @brief Borrows the calling thread's JSON parsing memory for the lifetime of
+ * the object.
+ *
+ * Every thread keeps one arena: a document, the buffers which its value pool
+ * and parse stack allocate from, and a SAX reader whose stack is kept between
+ * parses. Releasing the arena resets the pools rather than freeing them, so
+ * parsing a response usually doesn't touch the heap except to build model
+ * objects. When a parse overflows the value buffer, the buffer is grown for
+ * the next one, up to kMaxRetainedBytes.
+ *
+ * Arenas can be nested: if the thread's arena is already borrowed, a
+ * temporary one is created instead.
+ *
+ * @code{.cpp}
+ *   alpaca::ParseArena arena;
+ *   auto& d = arena.document();
+ *   if (d.Parse(resp->body.c_str()).HasParseError()) {
+ *     return alpaca::Status(1, "Received parse error when deserializing orders JSON");
+ *   }
+ * @endcode
+ */
+class ParseArena {
+ public:
+  /// The size of the value buffer a thread starts with
+  static constexpr size_t kInitialBytes = 64 * 1024;
+
+  /// The largest value buffer a thread keeps between parses
+  static constexpr size_t kMaxRetainedBytes = 8 * 1024 * 1024;
+
+  ParseArena();
+  ParseArena(const ParseArena&) = delete;
+  ParseArena& operator=(const ParseArena&) = delete;
+
+  /**
+   * @brief Resets the arena for the next parse on this thread.
+   *
+   * Values of the document must not be used after this.
+   */
+  ~ParseArena();
+
+  /**
+   * @brief An empty document to parse into.
+   */
+  PooledDocument& document();
+
+  /**
+   * @brief A SAX reader which reuses its stack between parses.
+   */
+  rapidjson::Reader& reader();
+
+  /**
+   * @brief The number of bytes in the value buffer of the calling thread's
+   * arena, or zero if it hasn't borrowed one yet.
+   */
+  static size_t retainedBytes();
+
+ private:
+  struct State;
+
+  /**
+   * @brief The calling thread's arena, which is created by the first parse.
+   */
+  static std::unique_ptr<State>& threadState();
+
+ private:
+  State* state_;
+
+  /// Set when the thread's arena was already borrowed
+  std::unique_ptr<State> temporary_;
+};
+} // namespace alpaca
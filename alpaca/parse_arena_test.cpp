@@ -0,0 +1,44 @@
+#include "alpaca/parse_arena.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+class ParseArenaTest : public ::testing::Test {};
+
+TEST_F(ParseArenaTest, testReusedPerThread) {
+  alpaca::PooledDocument* first;
+  rapidjson::Reader* reader;
+  {
+    alpaca::ParseArena arena;
+    first = &arena.document();
+    reader = &arena.reader();
+    ASSERT_FALSE(first->Parse("{\"symbol\": \"AAPL\"}").HasParseError());
+    EXPECT_STREQ((*first)["symbol"].GetString(), "AAPL");
+  }
+  EXPECT_EQ(alpaca::ParseArena::retainedBytes(), alpaca::ParseArena::kInitialBytes);
+
+  alpaca::ParseArena arena;
+  EXPECT_EQ(&arena.document(), first);
+  EXPECT_EQ(&arena.reader(), reader);
+  EXPECT_TRUE(arena.document().IsNull());
+
+  alpaca::PooledDocument* other = nullptr;
+  std::thread([&]() {
+    alpaca::ParseArena arena;
+    other = &arena.document();
+  }).join();
+  EXPECT_NE(other, first);
+}
+
+TEST_F(ParseArenaTest, testNested) {
+  alpaca::ParseArena outer;
+  ASSERT_FALSE(outer.document().Parse("{\"symbol\": \"AAPL\"}").HasParseError());
+  {
+    alpaca::ParseArena inner;
+    EXPECT_NE(&inner.document(), &outer.document());
+    ASSERT_FALSE(inner.document().Parse("{\"symbol\": \"TSLA\"}").HasParseError());
+    EXPECT_STREQ(inner.document()["symbol"].GetString(), "TSLA");
+  }
+  EXPECT_STREQ(outer.document()["symbol"].GetString(), "AAPL");
+}
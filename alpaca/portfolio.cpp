@@ -1,26 +1,27 @@
 #include "alpaca/portfolio.h"
 
-#include "alpaca/json.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
 
 namespace alpaca {
-Status PortfolioHistory::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing portfolio JSON");
-  }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a portfolio object");
-  }
+namespace {
+constexpr auto kPortfolioHistorySchema = makeSchema<PortfolioHistory>("a portfolio",
+    {
+        {"base_value", &PortfolioHistory::base_value},
+        {"equity", &PortfolioHistory::equity},
+        {"profit_loss", &PortfolioHistory::profit_loss},
+        {"profit_loss_pct", &PortfolioHistory::profit_loss_pct},
+        {"timeframe", &PortfolioHistory::timeframe},
+        {"timestamp", &PortfolioHistory::timestamp},
+    });
+} // namespace
 
-  PARSE_DOUBLE(base_value, "base_value")
-  PARSE_VECTOR_DOUBLES(equity, "equity")
-  PARSE_VECTOR_DOUBLES(profit_loss, "profit_loss")
-  PARSE_VECTOR_DOUBLES(profit_loss_pct, "profit_loss_pct")
-  PARSE_STRING(timeframe, "timeframe")
-  PARSE_VECTOR_UINT64(timestamp, "timestamp")
+Status PortfolioHistory::fromJSON(const std::string& json) {
+  return kPortfolioHistorySchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status PortfolioHistory::fromDocument(const rapidjson::Value& d) {
+  return kPortfolioHistorySchema.read(d, *this);
 }
 } // namespace alpaca
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "alpaca/status.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 class PortfolioHistory {
@@ -17,6 +18,16 @@ class PortfolioHistory {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   double base_value;
   std::vector<double> equity;
@@ -2,10 +2,32 @@
 
 #include <string>
 
+#include "alpaca/asset.h"
+#include "alpaca/decimal.h"
+#include "alpaca/enum.h"
 #include "alpaca/status.h"
+#include "alpaca/symbol.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
+/**
+ * @brief Whether a position is long or short.
+ */
+enum class PositionSide {
+  Long,
+  Short,
+  Unknown,
+};
+
+template <>
+struct EnumTraits<PositionSide> {
+  static constexpr EnumName<PositionSide> kNames[] = {
+      {"long", PositionSide::Long},
+      {"short", PositionSide::Short},
+  };
+};
+
 /**
  * @brief A type representing an Alpaca position.
  */
@@ -20,22 +42,32 @@ class Position {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
-  std::string asset_class;
+  Enum<AssetClass> asset_class;
   std::string asset_id;
-  std::string avg_entry_price;
-  std::string change_today;
-  std::string cost_basis;
-  std::string current_price;
-  std::string exchange;
-  std::string lastday_price;
-  std::string market_value;
-  std::string qty;
-  std::string side;
-  std::string symbol;
-  std::string unrealized_intraday_pl;
-  std::string unrealized_intraday_plpc;
-  std::string unrealized_pl;
-  std::string unrealized_plpc;
+  Decimal avg_entry_price;
+  Decimal change_today;
+  Decimal cost_basis;
+  Decimal current_price;
+  Enum<Exchange> exchange;
+  Decimal lastday_price;
+  Decimal market_value;
+  Decimal qty;
+  Enum<PositionSide> side;
+  SymbolId symbol;
+  Decimal unrealized_intraday_pl;
+  Decimal unrealized_intraday_plpc;
+  Decimal unrealized_pl;
+  Decimal unrealized_plpc;
 };
 } // namespace alpaca
\ No newline at end of file
@@ -29,5 +29,8 @@ const std::string kPositionJSON =
 TEST_F(PositionTest, testAccountConfigurationFromJSON) {
   alpaca::Position position;
   EXPECT_OK(position.fromJSON(kPositionJSON));
-  EXPECT_EQ(position.exchange, "NASDAQ");
+  EXPECT_EQ(position.exchange, alpaca::Exchange::NASDAQ);
+  EXPECT_EQ(position.side, alpaca::PositionSide::Long);
+  EXPECT_EQ(position.market_value - position.cost_basis, position.unrealized_pl);
+  EXPECT_EQ(position.avg_entry_price * position.qty, position.cost_basis);
 }
\ No newline at end of file
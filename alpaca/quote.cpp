@@ -1,55 +1,59 @@
 #include "alpaca/quote.h"
 
-#include "alpaca/json.h"
+#include "alpaca/parse_arena.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
 
 namespace alpaca {
-Status Quote::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing quote JSON");
-  }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a quote object");
-  }
+namespace {
+constexpr auto kQuoteSchema = makeSchema<Quote>("a quote",
+    {
+        {"askprice", &Quote::ask_price},
+        {"asksize", &Quote::ask_size},
+        {"askexchange", &Quote::ask_exchange},
+        {"bidprice", &Quote::bid_price},
+        {"bidsize", &Quote::bid_size},
+        {"bidexchange", &Quote::bid_exchange},
+        {"timestamp", &Quote::timestamp},
+    });
+
+constexpr auto kLastQuoteSchema = makeSchema<LastQuote>("a last quote",
+    {
+        {"status", &LastQuote::status},
+        {"symbol", &LastQuote::symbol},
+    });
+} // namespace
 
-  PARSE_DOUBLE(ask_price, "askprice")
-  PARSE_INT(ask_size, "asksize")
-  PARSE_INT(ask_exchange, "askexchange")
-  PARSE_DOUBLE(bid_price, "bidprice")
-  PARSE_INT(bid_size, "bidsize")
-  PARSE_INT(bid_exchange, "bidexchange")
-  PARSE_UINT64(timestamp, "timestamp")
+Status Quote::fromJSON(const std::string& json) {
+  return kQuoteSchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status Quote::fromDocument(const rapidjson::Value& d) {
+  return kQuoteSchema.read(d, *this);
 }
 
 Status LastQuote::fromJSON(const std::string& json) {
-  rapidjson::Document d;
+  ParseArena arena;
+  auto& d = arena.document();
   if (d.Parse(json.c_str()).HasParseError()) {
     return Status(1, "Received parse error when deserializing last quote JSON");
   }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a last quote object");
-  }
+  return fromDocument(d);
+}
 
-  PARSE_STRING(status, "status")
-  PARSE_STRING(symbol, "symbol")
+Status LastQuote::fromDocument(const rapidjson::Value& d) {
+  if (auto status = kLastQuoteSchema.read(d, *this); !status.ok()) {
+    return status;
+  }
 
   if (d.HasMember("last") && d["last"].IsObject()) {
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    d["last"].Accept(writer);
-    if (auto status = quote.fromJSON(s.GetString()); !status.ok()) {
+    if (auto status = quote.fromDocument(d["last"]); !status.ok()) {
       return status;
     }
   }
 
   return Status();
-};
+}
 } // namespace alpaca
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <string>
 
 #include "alpaca/status.h"
+#include "alpaca/symbol.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
@@ -20,6 +22,16 @@ class Quote {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   double ask_price;
   int ask_size;
@@ -44,9 +56,19 @@ class LastQuote {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   std::string status;
-  std::string symbol;
+  SymbolId symbol;
   Quote quote;
 };
 } // namespace alpaca
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "alpaca/rate_limiter.h"
+
+#include <algorithm>
+
+#include "glog/logging.h"
+
+namespace alpaca {
+
+RateLimiter::RateLimiter(size_t requests_per_minute)
+    : enabled_(requests_per_minute > 0),
+      capacity_(requests_per_minute),
+      tokens_per_second_(requests_per_minute / 60.0),
+      tokens_(requests_per_minute),
+      last_refill_(std::chrono::steady_clock::now()) {}
+
+void RateLimiter::acquire(const RequestPriority priority) {
+  if (!enabled_) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto ticket = next_ticket_++;
+  auto& queue = queues_[priority];
+  queue.push_back(ticket);
+
+  while (true) {
+    auto now = std::chrono::steady_clock::now();
+    refill(now);
+
+    auto turn = queue.front() == ticket && !higherPriorityWaiting(priority);
+    if (turn && now >= paused_until_ && tokens_ >= 1.0) {
+      tokens_ -= 1.0;
+      queue.pop_front();
+      // Let the next request in line re-evaluate its turn.
+      cv_.notify_all();
+      return;
+    }
+
+    if (!turn) {
+      cv_.wait(lock);
+    } else if (now < paused_until_) {
+      cv_.wait_until(lock, paused_until_);
+    } else {
+      auto wait = std::chrono::duration<double>((1.0 - tokens_) / tokens_per_second_);
+      cv_.wait_until(lock, now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait));
+    }
+  }
+}
+
+bool RateLimiter::tryAcquire(const RequestPriority priority) {
+  if (!enabled_) {
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto now = std::chrono::steady_clock::now();
+  refill(now);
+  if (now < paused_until_ || tokens_ < 1.0 || !queues_[priority].empty() || higherPriorityWaiting(priority)) {
+    return false;
+  }
+  tokens_ -= 1.0;
+  return true;
+}
+
+void RateLimiter::observe(const long limit, const long remaining, const std::time_t reset) {
+  if (!enabled_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  refill(std::chrono::steady_clock::now());
+
+  if (limit > 0 && limit != capacity_) {
+    DLOG(INFO) << "Rate limit reported by the API changed from " << capacity_ << " to " << limit << " per minute";
+    capacity_ = limit;
+    tokens_per_second_ = limit / 60.0;
+  }
+
+  if (remaining >= 0) {
+    tokens_ = std::min(tokens_, static_cast<double>(remaining));
+  }
+
+  if (remaining == 0 && reset > 0) {
+    auto seconds_until_reset = reset - std::time(nullptr);
+    if (seconds_until_reset > 0) {
+      auto until = std::chrono::steady_clock::now() + std::chrono::seconds(seconds_until_reset);
+      paused_until_ = std::max(paused_until_, until);
+    }
+  }
+  cv_.notify_all();
+}
+
+void RateLimiter::pause(const std::chrono::steady_clock::time_point until) {
+  if (!enabled_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  paused_until_ = std::max(paused_until_, until);
+  cv_.notify_all();
+}
+
+size_t RateLimiter::queueDepth(const RequestPriority priority) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queues_[priority].size();
+}
+
+double RateLimiter::availableTokens() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tokens_;
+}
+
+bool RateLimiter::enabled() const {
+  return enabled_;
+}
+
+void RateLimiter::refill(const std::chrono::steady_clock::time_point now) {
+  std::chrono::duration<double> elapsed = now - last_refill_;
+  if (elapsed.count() > 0) {
+    tokens_ = std::min(capacity_, tokens_ + elapsed.count() * tokens_per_second_);
+    last_refill_ = now;
+  }
+}
+
+bool RateLimiter::higherPriorityWaiting(const RequestPriority priority) const {
+  for (size_t i = 0; i < static_cast<size_t>(priority); ++i) {
+    if (!queues_[i].empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace alpaca
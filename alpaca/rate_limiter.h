@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <mutex>
+
+namespace alpaca {
+
+/**
+ * @brief The priority lanes of the client-side rate limiter.
+ *
+ * Lanes are listed from highest to lowest priority. A request is never sent
+ * while a request in a higher priority lane is waiting for budget.
+ */
+enum RequestPriority {
+  /// Order cancellations
+  CancelPriority,
+  /// Order submission, replacement and position liquidation
+  OrderPriority,
+  /// Account, order and position reads
+  AccountPriority,
+  /// Market data, history and reference data such as assets
+  DataPriority,
+};
+
+/// The number of RequestPriority lanes
+const size_t kRequestPriorities = 4;
+
+/**
+ * @brief A token bucket which schedules requests by priority.
+ *
+ * The bucket holds up to one minute of request budget and refills
+ * continuously. Budget reported by the API in rate limit response headers is
+ * fed back through observe() so that the limiter also accounts for requests
+ * made by other processes using the same API key.
+ *
+ * @code{.cpp}
+ *   auto limiter = alpaca::RateLimiter(200);
+ *   limiter.acquire(alpaca::RequestPriority::CancelPriority);
+ *   // send the request
+ * @endcode
+ */
+class RateLimiter {
+ public:
+  /**
+   * @brief The primary constructor.
+   *
+   * @param requests_per_minute The request budget per minute. A budget of zero
+   * disables rate limiting.
+   */
+  explicit RateLimiter(size_t requests_per_minute);
+
+  /**
+   * @brief The default constructor of RateLimiter should never be used.
+   */
+  explicit RateLimiter() = delete;
+
+  RateLimiter(const RateLimiter&) = delete;
+  RateLimiter& operator=(const RateLimiter&) = delete;
+
+  /**
+   * @brief Block until a request in the given lane may be sent.
+   */
+  void acquire(const RequestPriority priority);
+
+  /**
+   * @brief Take budget for a request in the given lane only if it is available
+   * immediately.
+   *
+   * @return true if the request may be sent.
+   */
+  bool tryAcquire(const RequestPriority priority);
+
+  /**
+   * @brief Calibrate the limiter from the rate limit headers of a response.
+   *
+   * @param limit The value of X-RateLimit-Limit, or a negative value if absent.
+   * @param remaining The value of X-RateLimit-Remaining, or a negative value if
+   * absent.
+   * @param reset The value of X-RateLimit-Reset as a UNIX timestamp, or zero if
+   * absent.
+   */
+  void observe(const long limit, const long remaining, const std::time_t reset);
+
+  /**
+   * @brief Stop sending requests until the given time.
+   *
+   * Used when the API rejects a request with an HTTP 429.
+   */
+  void pause(const std::chrono::steady_clock::time_point until);
+
+  /**
+   * @brief The number of requests waiting for budget in the given lane.
+   */
+  size_t queueDepth(const RequestPriority priority) const;
+
+  /**
+   * @brief The number of requests which could be sent immediately.
+   */
+  double availableTokens() const;
+
+  /**
+   * @brief Indicates whether or not rate limiting is enabled.
+   */
+  bool enabled() const;
+
+ private:
+  /**
+   * @brief Add the budget which has accrued since the last refill.
+   */
+  void refill(const std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief Indicates whether a request in a higher priority lane is waiting.
+   */
+  bool higherPriorityWaiting(const RequestPriority priority) const;
+
+ private:
+  bool enabled_;
+  double capacity_;
+  double tokens_per_second_;
+  double tokens_;
+  std::chrono::steady_clock::time_point last_refill_;
+  std::chrono::steady_clock::time_point paused_until_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::array<std::deque<uint64_t>, kRequestPriorities> queues_;
+  uint64_t next_ticket_ = 0;
+};
+} // namespace alpaca
@@ -0,0 +1,74 @@
+#include "alpaca/rate_limiter.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class RateLimiterTest : public ::testing::Test {};
+
+namespace {
+void waitForQueueDepth(const alpaca::RateLimiter& limiter, alpaca::RequestPriority priority, size_t depth) {
+  while (limiter.queueDepth(priority) != depth) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+} // namespace
+
+TEST_F(RateLimiterTest, testDisabled) {
+  alpaca::RateLimiter limiter(0);
+  EXPECT_FALSE(limiter.enabled());
+  for (int i = 0; i < 1000; ++i) {
+    limiter.acquire(alpaca::DataPriority);
+  }
+}
+
+TEST_F(RateLimiterTest, testBurst) {
+  alpaca::RateLimiter limiter(200);
+  EXPECT_TRUE(limiter.enabled());
+  for (int i = 0; i < 100; ++i) {
+    limiter.acquire(alpaca::AccountPriority);
+  }
+  EXPECT_LE(limiter.availableTokens(), 101);
+  EXPECT_EQ(limiter.queueDepth(alpaca::AccountPriority), 0);
+}
+
+TEST_F(RateLimiterTest, testObserveRemaining) {
+  alpaca::RateLimiter limiter(200);
+  limiter.observe(200, 10, 0);
+  EXPECT_LT(limiter.availableTokens(), 11);
+}
+
+TEST_F(RateLimiterTest, testTryAcquire) {
+  alpaca::RateLimiter limiter(60);
+  limiter.observe(-1, 1, 0);
+  EXPECT_TRUE(limiter.tryAcquire(alpaca::CancelPriority));
+  EXPECT_FALSE(limiter.tryAcquire(alpaca::CancelPriority));
+}
+
+TEST_F(RateLimiterTest, testPriorityOrder) {
+  // 60 requests per minute refills one token every second.
+  alpaca::RateLimiter limiter(60);
+  limiter.observe(-1, 0, 0);
+
+  std::mutex mutex;
+  std::vector<alpaca::RequestPriority> order;
+  auto request = [&](alpaca::RequestPriority priority) {
+    limiter.acquire(priority);
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(priority);
+  };
+
+  auto data = std::thread(request, alpaca::DataPriority);
+  waitForQueueDepth(limiter, alpaca::DataPriority, 1);
+  auto cancel = std::thread(request, alpaca::CancelPriority);
+  waitForQueueDepth(limiter, alpaca::CancelPriority, 1);
+
+  data.join();
+  cancel.join();
+  ASSERT_EQ(order.size(), 2);
+  EXPECT_EQ(order[0], alpaca::CancelPriority);
+  EXPECT_EQ(order[1], alpaca::DataPriority);
+}
@@ -0,0 +1,38 @@
+#include "alpaca/response_cache.h"
+
+#include <mutex>
+
+namespace alpaca {
+
+void ResponseCache::invalidate() {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  entries_.clear();
+}
+
+void ResponseCache::invalidate(const std::string& prefix) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  auto it = entries_.lower_bound(prefix);
+  while (it != entries_.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+    it = entries_.erase(it);
+  }
+}
+
+size_t ResponseCache::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void ResponseCache::insert(const std::string& key, Entry entry) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  // Expired entries are swept once as many values have been inserted as are
+  // cached, which keeps the cost of sweeping constant per insert.
+  if (++inserts_since_sweep_ >= entries_.size()) {
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      it = it->second.expires <= now ? entries_.erase(it) : std::next(it);
+    }
+    inserts_since_sweep_ = 0;
+  }
+  entries_.insert_or_assign(key, std::move(entry));
+}
+} // namespace alpaca
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <typeindex>
+
+namespace alpaca {
+
+/**
+ * @brief An in-memory cache of parsed API responses with per-entry expiry.
+ *
+ * Values are stored as shared immutable objects, so a hit hands out another
+ * reference to the cached object rather than a copy of it.
+ *
+ * @code{.cpp}
+ *   auto cache = alpaca::ResponseCache();
+ *   cache.put("asset/AAPL", std::make_shared<const alpaca::Asset>(asset), std::chrono::minutes(5));
+ *   if (auto asset = cache.get<alpaca::Asset>("asset/AAPL")) {
+ *     LOG(INFO) << "Tradable: " << asset->tradable;
+ *   }
+ * @endcode
+ */
+class ResponseCache {
+ public:
+  ResponseCache() = default;
+  ResponseCache(const ResponseCache&) = delete;
+  ResponseCache& operator=(const ResponseCache&) = delete;
+
+  /**
+   * @brief The cached value for a key.
+   *
+   * @return the value, or nullptr if the key is missing, has expired or holds a
+   * value of another type.
+   */
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.type != std::type_index(typeid(T)) ||
+        it->second.expires <= std::chrono::steady_clock::now()) {
+      return nullptr;
+    }
+    return std::static_pointer_cast<const T>(it->second.value);
+  }
+
+  /**
+   * @brief Cache a value for the given amount of time.
+   */
+  template <typename T>
+  void put(const std::string& key, std::shared_ptr<const T> value, const std::chrono::milliseconds ttl) {
+    insert(key, Entry{std::move(value), std::type_index(typeid(T)), std::chrono::steady_clock::now() + ttl});
+  }
+
+  /**
+   * @brief Drop every cached value.
+   */
+  void invalidate();
+
+  /**
+   * @brief Drop every cached value whose key starts with prefix.
+   */
+  void invalidate(const std::string& prefix);
+
+  /**
+   * @brief The number of cached values, including expired ones which have not
+   * been dropped yet.
+   */
+  size_t size() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const void> value;
+    std::type_index type;
+    std::chrono::steady_clock::time_point expires;
+  };
+
+  /**
+   * @brief Store an entry, sweeping expired entries from time to time.
+   */
+  void insert(const std::string& key, Entry entry);
+
+ private:
+  mutable std::shared_mutex mutex_;
+  std::map<std::string, Entry> entries_;
+  size_t inserts_since_sweep_ = 0;
+};
+} // namespace alpaca
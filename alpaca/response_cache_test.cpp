@@ -0,0 +1,60 @@
+#include "alpaca/response_cache.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class ResponseCacheTest : public ::testing::Test {};
+
+TEST_F(ResponseCacheTest, testPutAndGet) {
+  alpaca::ResponseCache cache;
+  EXPECT_EQ(cache.get<std::string>("clock"), nullptr);
+
+  auto value = std::make_shared<const std::string>("open");
+  cache.put("clock", value, std::chrono::minutes(1));
+  auto cached = cache.get<std::string>("clock");
+  ASSERT_NE(cached, nullptr);
+  EXPECT_EQ(*cached, "open");
+  EXPECT_EQ(cached.get(), value.get());
+}
+
+TEST_F(ResponseCacheTest, testTypeMismatch) {
+  alpaca::ResponseCache cache;
+  cache.put("clock", std::make_shared<const std::string>("open"), std::chrono::minutes(1));
+  EXPECT_EQ(cache.get<int>("clock"), nullptr);
+  EXPECT_NE(cache.get<std::string>("clock"), nullptr);
+}
+
+TEST_F(ResponseCacheTest, testExpiry) {
+  alpaca::ResponseCache cache;
+  cache.put("clock", std::make_shared<const int>(1), std::chrono::milliseconds(10));
+  EXPECT_NE(cache.get<int>("clock"), nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(cache.get<int>("clock"), nullptr);
+
+  // Expired entries are swept as new values are inserted.
+  cache.put("calendar", std::make_shared<const int>(2), std::chrono::minutes(1));
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(ResponseCacheTest, testInvalidate) {
+  alpaca::ResponseCache cache;
+  cache.put("asset/AAPL", std::make_shared<const int>(1), std::chrono::minutes(1));
+  cache.put("asset/TSLA", std::make_shared<const int>(2), std::chrono::minutes(1));
+  cache.put("assets?active", std::make_shared<const int>(3), std::chrono::minutes(1));
+  cache.put("watchlists", std::make_shared<const int>(4), std::chrono::minutes(1));
+
+  cache.invalidate("asset/");
+  EXPECT_EQ(cache.get<int>("asset/AAPL"), nullptr);
+  EXPECT_EQ(cache.get<int>("asset/TSLA"), nullptr);
+  EXPECT_NE(cache.get<int>("assets?active"), nullptr);
+  EXPECT_NE(cache.get<int>("watchlists"), nullptr);
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.invalidate();
+  EXPECT_EQ(cache.size(), 0);
+}
@@ -0,0 +1,43 @@
+#include "alpaca/retry.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+namespace alpaca {
+
+bool isRetryableStatus(const int status) {
+  switch (status) {
+  case 429:
+  case 500:
+  case 502:
+  case 503:
+  case 504:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::chrono::milliseconds retryDelay(const RetryPolicy& policy, const size_t retry, const std::string& retry_after) {
+  if (!retry_after.empty()) {
+    // Only the delta-seconds form is supported, HTTP dates fall through to
+    // the regular backoff.
+    char* end = nullptr;
+    auto seconds = std::strtol(retry_after.c_str(), &end, 10);
+    if (end != retry_after.c_str() && seconds >= 0) {
+      return std::chrono::seconds(seconds);
+    }
+  }
+
+  auto bound = policy.initial_backoff;
+  for (size_t i = 1; i < retry && bound < policy.max_backoff; ++i) {
+    bound *= 2;
+  }
+  bound = std::min(bound, policy.max_backoff);
+
+  thread_local std::mt19937 generator(std::random_device{}());
+  std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution(0, bound.count());
+  return std::chrono::milliseconds(distribution(generator));
+}
+} // namespace alpaca
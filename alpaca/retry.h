@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "alpaca/config.h"
+
+namespace alpaca {
+
+/**
+ * @brief Indicates whether a request which failed with the given HTTP status
+ * may succeed if it is retried.
+ */
+bool isRetryableStatus(const int status);
+
+/**
+ * @brief The delay before the given retry of a request.
+ *
+ * The delay is drawn uniformly from zero to an exponentially growing bound
+ * ("full jitter") so that clients which failed together do not retry together.
+ * A Retry-After header sent by the API takes precedence over the backoff.
+ *
+ * @param policy The retry policy to apply.
+ * @param retry The number of the retry, starting at one.
+ * @param retry_after The value of the Retry-After response header, if any.
+ */
+std::chrono::milliseconds retryDelay(const RetryPolicy& policy, const size_t retry, const std::string& retry_after);
+} // namespace alpaca
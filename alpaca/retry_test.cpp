@@ -0,0 +1,33 @@
+#include "alpaca/retry.h"
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class RetryTest : public ::testing::Test {};
+
+TEST_F(RetryTest, testIsRetryableStatus) {
+  EXPECT_TRUE(alpaca::isRetryableStatus(429));
+  EXPECT_TRUE(alpaca::isRetryableStatus(502));
+  EXPECT_TRUE(alpaca::isRetryableStatus(503));
+  EXPECT_FALSE(alpaca::isRetryableStatus(200));
+  EXPECT_FALSE(alpaca::isRetryableStatus(403));
+  EXPECT_FALSE(alpaca::isRetryableStatus(422));
+}
+
+TEST_F(RetryTest, testRetryDelayIsBounded) {
+  alpaca::RetryPolicy policy;
+  policy.initial_backoff = std::chrono::milliseconds(100);
+  policy.max_backoff = std::chrono::milliseconds(1000);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_LE(alpaca::retryDelay(policy, 1, "").count(), 100);
+    EXPECT_LE(alpaca::retryDelay(policy, 3, "").count(), 400);
+    EXPECT_LE(alpaca::retryDelay(policy, 50, "").count(), 1000);
+    EXPECT_GE(alpaca::retryDelay(policy, 50, "").count(), 0);
+  }
+}
+
+TEST_F(RetryTest, testRetryDelayHonorsRetryAfter) {
+  alpaca::RetryPolicy policy;
+  EXPECT_EQ(alpaca::retryDelay(policy, 1, "7"), std::chrono::seconds(7));
+  EXPECT_LE(alpaca::retryDelay(policy, 1, "Wed, 21 Oct 2015 07:28:00 GMT"), policy.initial_backoff);
+}
@@ -0,0 +1,617 @@
+#pragma once
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "alpaca/decimal.h"
+#include "alpaca/enum.h"
+#include "alpaca/parse_arena.h"
+#include "alpaca/status.h"
+#include "alpaca/symbol.h"
+#include "alpaca/timestamp.h"
+#include "rapidjson/document.h"
+#include "rapidjson/encodedstream.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
+
+namespace alpaca {
+
+/**
+ * @brief The kinds of member which a JSON field can be deserialized into.
+ */
+enum class FieldType {
+  String,
+  Bool,
+  Int,
+  Uint,
+  Uint64,
+  Double,
+  Decimal,
+  Timestamp,
+  Enum,
+  Symbol,
+  DoubleVector,
+  Uint64Vector,
+};
+
+/**
+ * @brief A JSON field of a model and the member it is deserialized into.
+ *
+ * The type of the field is inferred from the type of the member.
+ */
+template <typename T>
+struct Field {
+  constexpr Field() = default;
+  constexpr Field(const char* n, std::string T::*m) : Field(n, FieldType::String) {
+    string = m;
+  }
+  constexpr Field(const char* n, bool T::*m) : Field(n, FieldType::Bool) {
+    boolean = m;
+  }
+  constexpr Field(const char* n, int T::*m) : Field(n, FieldType::Int) {
+    integer = m;
+  }
+  constexpr Field(const char* n, unsigned T::*m) : Field(n, FieldType::Uint) {
+    unsigned_integer = m;
+  }
+  constexpr Field(const char* n, uint64_t T::*m) : Field(n, FieldType::Uint64) {
+    unsigned_integer64 = m;
+  }
+  constexpr Field(const char* n, double T::*m) : Field(n, FieldType::Double) {
+    real = m;
+  }
+  constexpr Field(const char* n, Decimal T::*m) : Field(n, FieldType::Decimal) {
+    decimal = m;
+  }
+  constexpr Field(const char* n, Timestamp T::*m) : Field(n, FieldType::Timestamp) {
+    timestamp = m;
+  }
+  constexpr Field(const char* n, SymbolId T::*m) : Field(n, FieldType::Symbol) {
+    symbol = m;
+  }
+  constexpr Field(const char* n, void (*f)(T&, const char*, size_t)) : Field(n, FieldType::Enum) {
+    enumeration = f;
+  }
+  constexpr Field(const char* n, std::vector<double> T::*m) : Field(n, FieldType::DoubleVector) {
+    reals = m;
+  }
+  constexpr Field(const char* n, std::vector<uint64_t> T::*m) : Field(n, FieldType::Uint64Vector) {
+    unsigned_integers64 = m;
+  }
+
+  const char* name = "";
+  size_t length = 0;
+  FieldType type = FieldType::String;
+
+  std::string T::*string = nullptr;
+  bool T::*boolean = nullptr;
+  int T::*integer = nullptr;
+  unsigned T::*unsigned_integer = nullptr;
+  uint64_t T::*unsigned_integer64 = nullptr;
+  double T::*real = nullptr;
+  Decimal T::*decimal = nullptr;
+  Timestamp T::*timestamp = nullptr;
+  void (*enumeration)(T&, const char*, size_t) = nullptr;
+  SymbolId T::*symbol = nullptr;
+  std::vector<double> T::*reals = nullptr;
+  std::vector<uint64_t> T::*unsigned_integers64 = nullptr;
+
+ private:
+  constexpr Field(const char* n, const FieldType t) : name(n), length(nameLength(n)), type(t) {}
+
+  static constexpr size_t nameLength(const char* n) {
+    size_t i = 0;
+    while (n[i] != '\0') {
+      ++i;
+    }
+    return i;
+  }
+};
+
+namespace detail {
+template <typename M>
+struct MemberOf;
+
+template <typename C, typename V>
+struct MemberOf<V C::*> {
+  using Class = C;
+  using Value = V;
+};
+} // namespace detail
+
+/**
+ * @brief Sets an Enum member from its JSON string. Schemas refer to an
+ * instantiation of this for each Enum member:
+ *
+ * @code{.cpp}
+ *   {"side", &alpaca::parseEnum<&alpaca::Order::side>},
+ * @endcode
+ */
+template <auto Member>
+void parseEnum(typename detail::MemberOf<decltype(Member)>::Class& out, const char* str, const size_t length) {
+  out.*Member = detail::MemberOf<decltype(Member)>::Value::parse(str, length);
+}
+
+namespace detail {
+/**
+ * @brief Seeded FNV-1a, finished with the murmur3 mixer so that the low bits
+ * used to pick a slot depend on every bit of the seed.
+ */
+constexpr uint32_t hashKey(const char* key, const size_t length, const uint32_t seed) {
+  uint32_t hash = 2166136261u ^ seed;
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ static_cast<unsigned char>(key[i])) * 16777619u;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+constexpr bool sameName(const char* a, const char* b) {
+  while (*a != '\0' && *a == *b) {
+    ++a;
+    ++b;
+  }
+  return *a == *b;
+}
+
+/**
+ * @brief These are called during constant evaluation when a schema is
+ * invalid. Neither is constexpr, so they fail the build and name the problem.
+ */
+inline void schemaHasDuplicateFields() {}
+inline void schemaHasNoPerfectHash() {}
+} // namespace detail
+
+/**
+ * @brief A compile-time table of the JSON fields of a model, which
+ * deserializes JSON straight into the model's members.
+ *
+ * Keys are dispatched with a perfect hash which is found when the schema is
+ * constructed, so a schema must be a constexpr variable:
+ *
+ * @code{.cpp}
+ *   constexpr auto kClockSchema = alpaca::makeSchema<alpaca::Clock>("a clock",
+ *       {
+ *           {"is_open", &alpaca::Clock::is_open},
+ *           {"next_close", &alpaca::Clock::next_close},
+ *           {"next_open", &alpaca::Clock::next_open},
+ *           {"timestamp", &alpaca::Clock::timestamp},
+ *       });
+ *
+ *   alpaca::Clock clock;
+ *   auto status = kClockSchema.parse(json.data(), json.size(), clock);
+ * @endcode
+ *
+ * As with the DOM, a field is only set when its JSON value has a compatible
+ * type, keys which aren't in the schema are skipped, and members whose keys
+ * are missing keep their values. Decimal members are read from strings and
+ * integers, since a double may already have lost digits, Timestamp members
+ * from RFC3339 strings, Enum members from strings with parseEnum(), and
+ * SymbolId members by interning strings.
+ *
+ * A Decimal or Timestamp field whose value is there but can't be read
+ * exactly, such as a malformed string or a number with a fraction sent for a
+ * Decimal, fails the whole object rather than leaving a stale or empty
+ * member which looks like a missing one.
+ */
+template <typename T, size_t N>
+class Schema {
+  static_assert(N > 0 && N < 255, "A schema must have between 1 and 254 fields");
+
+ public:
+  constexpr Schema(const char* name, const Field<T> (&fields)[N]) : name_(name) {
+    for (size_t i = 0; i < N; ++i) {
+      fields_[i] = fields[i];
+      for (size_t j = 0; j < i; ++j) {
+        if (detail::sameName(fields[i].name, fields[j].name)) {
+          detail::schemaHasDuplicateFields();
+        }
+      }
+    }
+    while (!tryHash(seed_)) {
+      if (++seed_ == kMaxSeeds) {
+        detail::schemaHasNoPerfectHash();
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Deserialize an already parsed JSON object.
+   */
+  Status read(const rapidjson::Value& d, T& out) const {
+    if (!d.IsObject()) {
+      return notAnObject();
+    }
+    for (auto member = d.MemberBegin(); member != d.MemberEnd(); ++member) {
+      if (auto field = find(member->name.GetString(), member->name.GetStringLength()); field != nullptr) {
+        if (!assign(*field, member->value, out)) {
+          return invalidField(*field);
+        }
+      }
+    }
+    return Status();
+  }
+
+  /**
+   * @brief Deserialize a JSON object with a SAX reader, without building a
+   * DOM of it.
+   *
+   * Fields which precede a syntax error will have been set.
+   */
+  Status parse(const char* json, const size_t length, T& out) const {
+    Handler handler(*this, out);
+    rapidjson::MemoryStream ms(json, length);
+    rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream> is(ms);
+    ParseArena arena;
+    auto& reader = arena.reader();
+    if (reader.Parse(is, handler).IsError()) {
+      if (handler.notAnObject()) {
+        return notAnObject();
+      }
+      if (auto field = handler.invalidField(); field != nullptr) {
+        return invalidField(*field);
+      }
+      std::ostringstream ss;
+      ss << "Received parse error when deserializing " << name_ << " at offset " << reader.GetErrorOffset() << ": "
+         << rapidjson::GetParseError_En(reader.GetParseErrorCode());
+      return Status(1, ss.str());
+    }
+    return Status();
+  }
+
+  /**
+   * @brief The field with a key, or null if the key isn't in the schema.
+   */
+  const Field<T>* find(const char* key, const size_t length) const {
+    auto index = slots_[detail::hashKey(key, length, seed_) & (kSlots - 1)];
+    if (index == kEmpty) {
+      return nullptr;
+    }
+    const auto& field = fields_[index];
+    if (field.length != length || std::memcmp(field.name, key, length) != 0) {
+      return nullptr;
+    }
+    return &field;
+  }
+
+ private:
+  /**
+   * @brief A rapidjson SAX handler which sets the fields of one object.
+   *
+   * depth_ is the number of containers which are open, so member values are
+   * read at depth 1 and the elements of a vector field at depth 2. Values of
+   * unknown keys and nested containers are skipped.
+   */
+  class Handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+   public:
+    Handler(const Schema& schema, T& out) : schema_(schema), out_(out) {}
+
+    bool Null() {
+      return depth_ > 0 || fail();
+    }
+    bool Bool(bool b) {
+      if (auto field = member(); field != nullptr) {
+        setBool(*field, out_, b);
+      }
+      return depth_ > 0 || fail();
+    }
+    bool Int(int i) {
+      return Int64(i);
+    }
+    bool Uint(unsigned u) {
+      return Uint64(u);
+    }
+    bool Int64(int64_t i) {
+      if (i >= 0) {
+        return Uint64(static_cast<uint64_t>(i));
+      }
+      if (auto field = member(); field != nullptr) {
+        if (!setSigned(*field, out_, i)) {
+          return invalid(field);
+        }
+      } else if (auto field = element(); field != nullptr) {
+        appendReal(*field, out_, static_cast<double>(i));
+      }
+      return depth_ > 0 || fail();
+    }
+    bool Uint64(uint64_t u) {
+      if (auto field = member(); field != nullptr) {
+        if (!setUnsigned(*field, out_, u)) {
+          return invalid(field);
+        }
+      } else if (auto field = element(); field != nullptr) {
+        appendUnsigned(*field, out_, u);
+      }
+      return depth_ > 0 || fail();
+    }
+    bool Double(double d) {
+      if (auto field = member(); field != nullptr) {
+        if (!setReal(*field, out_, d)) {
+          return invalid(field);
+        }
+      } else if (auto field = element(); field != nullptr) {
+        appendReal(*field, out_, d);
+      }
+      return depth_ > 0 || fail();
+    }
+    bool String(const char* str, rapidjson::SizeType length, bool) {
+      if (auto field = member(); field != nullptr && !setString(*field, out_, str, length)) {
+        return invalid(field);
+      }
+      return depth_ > 0 || fail();
+    }
+
+    bool StartObject() {
+      ++depth_;
+      return true;
+    }
+    bool Key(const char* str, rapidjson::SizeType length, bool) {
+      if (depth_ == 1) {
+        field_ = schema_.find(str, length);
+      }
+      return true;
+    }
+    bool EndObject(rapidjson::SizeType) {
+      --depth_;
+      return true;
+    }
+
+    bool StartArray() {
+      if (depth_ == 0) {
+        return fail();
+      }
+      if (auto field = member(); field != nullptr && clearVector(*field, out_)) {
+        in_vector_ = true;
+      }
+      ++depth_;
+      return true;
+    }
+    bool EndArray(rapidjson::SizeType) {
+      if (--depth_ == 1) {
+        in_vector_ = false;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Whether parsing stopped because the JSON wasn't an object.
+     */
+    bool notAnObject() const {
+      return not_an_object_;
+    }
+
+    /**
+     * @brief The field whose value couldn't be read, if that stopped parsing.
+     */
+    const Field<T>* invalidField() const {
+      return invalid_field_;
+    }
+
+   private:
+    const Field<T>* member() const {
+      return depth_ == 1 ? field_ : nullptr;
+    }
+
+    const Field<T>* element() const {
+      return depth_ == 2 && in_vector_ ? field_ : nullptr;
+    }
+
+    bool fail() {
+      not_an_object_ = true;
+      return false;
+    }
+
+    bool invalid(const Field<T>* field) {
+      invalid_field_ = field;
+      return false;
+    }
+
+   private:
+    const Schema& schema_;
+    T& out_;
+    const Field<T>* field_ = nullptr;
+    size_t depth_ = 0;
+    bool in_vector_ = false;
+    bool not_an_object_ = false;
+    const Field<T>* invalid_field_ = nullptr;
+  };
+
+  /**
+   * @brief Set a member from a DOM value.
+   *
+   * @return false if the value was for a Decimal or Timestamp member but
+   * couldn't be read as one.
+   */
+  static bool assign(const Field<T>& field, const rapidjson::Value& v, T& out) {
+    if (v.IsString()) {
+      return setString(field, out, v.GetString(), v.GetStringLength());
+    } else if (v.IsBool()) {
+      setBool(field, out, v.GetBool());
+    } else if (v.IsUint64()) {
+      return setUnsigned(field, out, v.GetUint64());
+    } else if (v.IsInt64()) {
+      return setSigned(field, out, v.GetInt64());
+    } else if (v.IsNumber()) {
+      return setReal(field, out, v.GetDouble());
+    } else if (v.IsArray() && clearVector(field, out)) {
+      for (const auto& item : v.GetArray()) {
+        if (item.IsUint64()) {
+          appendUnsigned(field, out, item.GetUint64());
+        } else if (item.IsNumber()) {
+          appendReal(field, out, item.GetDouble());
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Set a member from a JSON string. This and the setters for numbers
+   * return false when the value was for a Decimal or Timestamp member but
+   * can't be read as one exactly; values of other mismatched types are
+   * skipped.
+   */
+  static bool setString(const Field<T>& field, T& out, const char* str, const size_t length) {
+    if (field.type == FieldType::String) {
+      (out.*field.string).assign(str, length);
+    } else if (field.type == FieldType::Decimal) {
+      return Decimal::parse(str, length, out.*field.decimal).ok();
+    } else if (field.type == FieldType::Timestamp) {
+      return Timestamp::parse(str, length, out.*field.timestamp).ok();
+    } else if (field.type == FieldType::Enum) {
+      field.enumeration(out, str, length);
+    } else if (field.type == FieldType::Symbol) {
+      out.*field.symbol = SymbolId::intern(str, length);
+    }
+    return true;
+  }
+
+  static void setBool(const Field<T>& field, T& out, const bool value) {
+    if (field.type == FieldType::Bool) {
+      out.*field.boolean = value;
+    }
+  }
+
+  static bool setUnsigned(const Field<T>& field, T& out, const uint64_t value) {
+    switch (field.type) {
+    case FieldType::Int:
+      if (value <= INT_MAX) {
+        out.*field.integer = static_cast<int>(value);
+      }
+      break;
+    case FieldType::Uint:
+      if (value <= UINT_MAX) {
+        out.*field.unsigned_integer = static_cast<unsigned>(value);
+      }
+      break;
+    case FieldType::Uint64:
+      out.*field.unsigned_integer64 = value;
+      break;
+    case FieldType::Double:
+      out.*field.real = static_cast<double>(value);
+      break;
+    case FieldType::Decimal:
+      if (value > INT64_MAX) {
+        return false;
+      }
+      out.*field.decimal = Decimal::fromMantissa(static_cast<int64_t>(value), 0);
+      break;
+    default:
+      break;
+    }
+    return true;
+  }
+
+  static bool setSigned(const Field<T>& field, T& out, const int64_t value) {
+    if (field.type == FieldType::Int && value >= INT_MIN && value <= INT_MAX) {
+      out.*field.integer = static_cast<int>(value);
+    } else if (field.type == FieldType::Double) {
+      out.*field.real = static_cast<double>(value);
+    } else if (field.type == FieldType::Decimal) {
+      out.*field.decimal = Decimal::fromMantissa(value, 0);
+    }
+    return true;
+  }
+
+  static bool setReal(const Field<T>& field, T& out, const double value) {
+    if (field.type == FieldType::Double) {
+      out.*field.real = value;
+    }
+    // The double has already been rounded to binary, so it is no decimal.
+    return field.type != FieldType::Decimal;
+  }
+
+  static bool clearVector(const Field<T>& field, T& out) {
+    if (field.type == FieldType::DoubleVector) {
+      (out.*field.reals).clear();
+      return true;
+    } else if (field.type == FieldType::Uint64Vector) {
+      (out.*field.unsigned_integers64).clear();
+      return true;
+    }
+    return false;
+  }
+
+  static void appendUnsigned(const Field<T>& field, T& out, const uint64_t value) {
+    if (field.type == FieldType::DoubleVector) {
+      (out.*field.reals).push_back(static_cast<double>(value));
+    } else if (field.type == FieldType::Uint64Vector) {
+      (out.*field.unsigned_integers64).push_back(value);
+    }
+  }
+
+  static void appendReal(const Field<T>& field, T& out, const double value) {
+    if (field.type == FieldType::DoubleVector) {
+      (out.*field.reals).push_back(value);
+    }
+  }
+
+  Status notAnObject() const {
+    return Status(1, std::string("Deserialized valid JSON but it wasn't ") + name_ + " object");
+  }
+
+  Status invalidField(const Field<T>& field) const {
+    const char* kind = field.type == FieldType::Decimal ? "a decimal" : "a timestamp";
+    return Status(1, std::string("Received ") + field.name + " which isn't " + kind + " when deserializing " + name_);
+  }
+
+  /**
+   * @brief Lay the fields out by their hash with a seed, failing on the first
+   * collision.
+   */
+  constexpr bool tryHash(const uint32_t seed) {
+    for (auto& slot : slots_) {
+      slot = kEmpty;
+    }
+    for (size_t i = 0; i < N; ++i) {
+      auto& slot = slots_[detail::hashKey(fields_[i].name, fields_[i].length, seed) & (kSlots - 1)];
+      if (slot != kEmpty) {
+        return false;
+      }
+      slot = static_cast<uint8_t>(i);
+    }
+    return true;
+  }
+
+  /// The smallest power of two which is at least four times the number of
+  /// fields, so that a collision-free seed is found after a few tries.
+  static constexpr size_t slotCount() {
+    size_t slots = 1;
+    while (slots < 4 * N) {
+      slots *= 2;
+    }
+    return slots;
+  }
+
+  static constexpr size_t kSlots = slotCount();
+  static constexpr uint8_t kEmpty = 0xff;
+  static constexpr uint32_t kMaxSeeds = 1 << 12;
+
+  const char* name_;
+  std::array<Field<T>, N> fields_{};
+  std::array<uint8_t, kSlots> slots_{};
+  uint32_t seed_ = 0;
+};
+
+/**
+ * @brief Build a schema, deducing the number of fields.
+ *
+ * @param name What the JSON describes, such as "an order", for error messages.
+ */
+template <typename T, size_t N>
+constexpr Schema<T, N> makeSchema(const char* name, const Field<T> (&fields)[N]) {
+  return Schema<T, N>(name, fields);
+}
+} // namespace alpaca
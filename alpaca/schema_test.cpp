@@ -0,0 +1,157 @@
+#include "alpaca/schema.h"
+
+#include <string>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+#include "rapidjson/document.h"
+
+class SchemaTest : public ::testing::Test {};
+
+namespace {
+struct Example {
+  std::string name;
+  bool active = false;
+  int count = 0;
+  unsigned size = 0;
+  uint64_t timestamp = 0;
+  double price = 0;
+  alpaca::Decimal cost;
+  std::vector<double> values;
+  std::vector<uint64_t> times;
+};
+
+constexpr auto kExampleSchema = alpaca::makeSchema<Example>("an example",
+    {
+        {"name", &Example::name},
+        {"active", &Example::active},
+        {"count", &Example::count},
+        {"size", &Example::size},
+        {"timestamp", &Example::timestamp},
+        {"price", &Example::price},
+        {"cost", &Example::cost},
+        {"values", &Example::values},
+        {"times", &Example::times},
+    });
+
+const std::string kExampleJSON =
+    "{"
+    "\"name\": \"AAPL\","
+    "\"nested\": {\"name\": \"TSLA\", \"count\": 7},"
+    "\"active\": true,"
+    "\"count\": -3,"
+    "\"size\": 12,"
+    "\"timestamp\": 1580503500000000000,"
+    "\"price\": 10,"
+    "\"cost\": \"10.50\","
+    "\"values\": [1.5, null, -2, 3],"
+    "\"times\": [1, 2.5, 3],"
+    "\"unknown\": [{\"price\": 99}]"
+    "}";
+
+void expectExample(const Example& example) {
+  EXPECT_EQ(example.name, "AAPL");
+  EXPECT_TRUE(example.active);
+  EXPECT_EQ(example.count, -3);
+  EXPECT_EQ(example.size, 12);
+  EXPECT_EQ(example.timestamp, 1580503500000000000ull);
+  EXPECT_EQ(example.price, 10);
+  EXPECT_EQ(example.cost.toString(), "10.50");
+  EXPECT_EQ(example.values, std::vector<double>({1.5, -2, 3}));
+  EXPECT_EQ(example.times, std::vector<uint64_t>({1, 3}));
+}
+} // namespace
+
+TEST_F(SchemaTest, testFind) {
+  for (const std::string key : {"name", "active", "count", "size", "timestamp", "price", "cost", "values", "times"}) {
+    auto field = kExampleSchema.find(key.data(), key.size());
+    ASSERT_NE(field, nullptr);
+    EXPECT_EQ(field->name, key);
+  }
+  EXPECT_EQ(kExampleSchema.find("nam", 3), nullptr);
+  EXPECT_EQ(kExampleSchema.find("names", 5), nullptr);
+  EXPECT_EQ(kExampleSchema.find("", 0), nullptr);
+}
+
+TEST_F(SchemaTest, testParse) {
+  Example example;
+  EXPECT_OK(kExampleSchema.parse(kExampleJSON.data(), kExampleJSON.size(), example));
+  expectExample(example);
+}
+
+TEST_F(SchemaTest, testRead) {
+  rapidjson::Document d;
+  ASSERT_FALSE(d.Parse(kExampleJSON.c_str()).HasParseError());
+  Example example;
+  EXPECT_OK(kExampleSchema.read(d, example));
+  expectExample(example);
+}
+
+TEST_F(SchemaTest, testMismatchedTypes) {
+  Example example;
+  example.name = "SPY";
+  example.count = 4;
+  example.size = 5;
+  const std::string json =
+      "{\"name\": 1, \"active\": \"yes\", \"count\": 1.5, \"size\": -1, \"price\": \"10\", \"cost\": null}";
+  EXPECT_OK(kExampleSchema.parse(json.data(), json.size(), example));
+  EXPECT_EQ(example.name, "SPY");
+  EXPECT_FALSE(example.active);
+  EXPECT_EQ(example.count, 4);
+  EXPECT_EQ(example.size, 5);
+  EXPECT_EQ(example.price, 0);
+  EXPECT_TRUE(example.cost.empty());
+}
+
+TEST_F(SchemaTest, testInvalidDecimalsAndTimestamps) {
+  struct Fill {
+    alpaca::Decimal price;
+    alpaca::Timestamp at;
+  };
+  constexpr auto kFillSchema = alpaca::makeSchema<Fill>("a fill",
+      {
+          {"price", &Fill::price},
+          {"at", &Fill::at},
+      });
+
+  for (const std::string json : {"{\"price\": \"10.5\", \"at\": \"2020-04-01\"}",
+                                 "{\"price\": 10, \"at\": \"\"}",
+                                 "{\"price\": \"\", \"at\": null}"}) {
+    Fill fill;
+    EXPECT_OK(kFillSchema.parse(json.data(), json.size(), fill));
+    rapidjson::Document d;
+    ASSERT_FALSE(d.Parse(json.c_str()).HasParseError());
+    EXPECT_OK(kFillSchema.read(d, fill));
+  }
+
+  for (const std::string json : {"{\"price\": 10.5}",
+                                 "{\"price\": \"ten\"}",
+                                 "{\"price\": 18446744073709551615}",
+                                 "{\"at\": \"2020-04-31\"}"}) {
+    Fill fill;
+    auto status = kFillSchema.parse(json.data(), json.size(), fill);
+    EXPECT_NOT_OK(status);
+    EXPECT_NE(status.getMessage().find("when deserializing a fill"), std::string::npos);
+    rapidjson::Document d;
+    ASSERT_FALSE(d.Parse(json.c_str()).HasParseError());
+    EXPECT_NOT_OK(kFillSchema.read(d, fill));
+  }
+
+  Fill fill;
+  const std::string json = "{\"price\": 1.5}";
+  EXPECT_EQ(kFillSchema.parse(json.data(), json.size(), fill).getMessage(),
+            "Received price which isn't a decimal when deserializing a fill");
+}
+
+TEST_F(SchemaTest, testNotAnObject) {
+  Example example;
+  for (const std::string json : {"[]", "3", "\"name\"", "null"}) {
+    auto status = kExampleSchema.parse(json.data(), json.size(), example);
+    EXPECT_NOT_OK(status);
+    EXPECT_EQ(status.getMessage(), "Deserialized valid JSON but it wasn't an example object");
+  }
+  for (const std::string json : {"", "{\"name\": ", "{\"name\": \"AAPL\"} {}"}) {
+    EXPECT_NOT_OK(kExampleSchema.parse(json.data(), json.size(), example));
+  }
+}
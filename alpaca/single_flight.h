@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace alpaca {
+
+/**
+ * @brief Coalesces concurrent calls which share a key into a single call.
+ *
+ * The first caller for a key runs the call; callers which arrive while it is
+ * in flight wait for and share its result instead of making their own call.
+ * Once the call completes the key is forgotten, so results are never reused
+ * by later callers.
+ *
+ * @code{.cpp}
+ *   auto in_flight = alpaca::SingleFlight<std::string>();
+ *   auto body = in_flight.run("/v2/clock", [&]() { return fetch("/v2/clock"); });
+ * @endcode
+ */
+template <typename T>
+class SingleFlight {
+ public:
+  SingleFlight() = default;
+  SingleFlight(const SingleFlight&) = delete;
+  SingleFlight& operator=(const SingleFlight&) = delete;
+
+  /**
+   * @brief Run call, or wait for the in-flight call with the same key.
+   *
+   * If the call throws, every caller waiting on it receives the exception.
+   *
+   * @param shared If not null, set to whether the result was handed to more
+   * than one caller, in which case it must not be modified.
+   */
+  T run(const std::string& key, const std::function<T()>& call, bool* shared = nullptr) {
+    std::promise<T> promise;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto it = calls_.find(key);
+      if (it != calls_.end()) {
+        auto future = it->second.result;
+        ++it->second.waiters;
+        lock.unlock();
+        ++coalesced_;
+        if (shared != nullptr) {
+          *shared = true;
+        }
+        return future.get();
+      }
+      calls_.emplace(key, Call{promise.get_future().share(), 0});
+    }
+
+    try {
+      auto result = call();
+      auto waiters = forget(key);
+      if (shared != nullptr) {
+        *shared = waiters > 0;
+      }
+      promise.set_value(result);
+      return result;
+    } catch (...) {
+      forget(key);
+      promise.set_exception(std::current_exception());
+      throw;
+    }
+  }
+
+  /**
+   * @brief The number of calls which shared the result of another call.
+   */
+  size_t coalesced() const {
+    return coalesced_;
+  }
+
+ private:
+  struct Call {
+    std::shared_future<T> result;
+    /// The number of callers waiting on the call rather than making their own
+    size_t waiters;
+  };
+
+  /**
+   * @return the number of callers which waited on the call.
+   */
+  size_t forget(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = calls_.find(key);
+    auto waiters = it->second.waiters;
+    calls_.erase(it);
+    return waiters;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, Call> calls_;
+  std::atomic<size_t> coalesced_{0};
+};
+} // namespace alpaca
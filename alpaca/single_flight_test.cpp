@@ -0,0 +1,70 @@
+#include "alpaca/single_flight.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class SingleFlightTest : public ::testing::Test {};
+
+TEST_F(SingleFlightTest, testConcurrentCallsAreCoalesced) {
+  alpaca::SingleFlight<int> in_flight;
+  std::atomic<int> calls{0};
+  std::atomic<bool> release{false};
+
+  std::vector<std::thread> threads;
+  std::vector<int> results(8);
+  std::array<bool, 8> shared{};
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      results[i] = in_flight.run(
+          "/v2/clock",
+          [&]() {
+            ++calls;
+            while (!release) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return 42;
+          },
+          &shared[i]);
+    });
+  }
+  while (in_flight.coalesced() + calls < results.size()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  release = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(in_flight.coalesced(), results.size() - 1);
+  for (auto result : results) {
+    EXPECT_EQ(result, 42);
+  }
+  // Every caller, including the one which made the call, shares the result.
+  for (auto result_shared : shared) {
+    EXPECT_TRUE(result_shared);
+  }
+}
+
+TEST_F(SingleFlightTest, testSequentialCallsAreNotCoalesced) {
+  alpaca::SingleFlight<int> in_flight;
+  auto calls = 0;
+  auto shared = true;
+  EXPECT_EQ(in_flight.run("key", [&]() { return ++calls; }, &shared), 1);
+  EXPECT_FALSE(shared);
+  EXPECT_EQ(in_flight.run("key", [&]() { return ++calls; }), 2);
+  EXPECT_EQ(in_flight.coalesced(), 0);
+}
+
+TEST_F(SingleFlightTest, testExceptionsPropagate) {
+  alpaca::SingleFlight<int> in_flight;
+  EXPECT_THROW(in_flight.run("key", []() -> int { throw std::runtime_error("failed"); }), std::runtime_error);
+  EXPECT_EQ(in_flight.run("key", []() { return 1; }), 1);
+}
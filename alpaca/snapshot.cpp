@@ -0,0 +1,323 @@
+#include "alpaca/snapshot.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace alpaca {
+
+namespace {
+const char kSnapshotMagic[] = {'A', 'L', 'P', 'A', 'C', 'A', 'S', 'S'};
+const uint32_t kSnapshotVersion = 2;
+
+/// The bits of the flags byte of a serialized asset
+enum AssetFlag {
+  EasyToBorrowFlag = 1 << 0,
+  MarginableFlag = 1 << 1,
+  ShortableFlag = 1 << 2,
+  TradableFlag = 1 << 3,
+};
+
+/**
+ * @brief Appends little-endian fixed width integers and length-prefixed
+ * strings to a buffer.
+ */
+class Encoder {
+ public:
+  void putUInt(uint64_t value, size_t width) {
+    for (size_t i = 0; i < width; ++i) {
+      buffer_.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+  }
+
+  void putString(const std::string& value) {
+    putUInt(value.size(), 4);
+    buffer_.append(value);
+  }
+
+  void putBytes(const char* data, size_t size) {
+    buffer_.append(data, size);
+  }
+
+  const std::string& buffer() const {
+    return buffer_;
+  }
+
+ private:
+  std::string buffer_;
+};
+
+/**
+ * @brief Reads values written by an Encoder, failing instead of reading past
+ * the end of the data.
+ */
+class Decoder {
+ public:
+  Decoder(const char* data, size_t size) : data_(data), size_(size) {}
+
+  bool getUInt(uint64_t& value, size_t width) {
+    if (size_ - offset_ < width) {
+      return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < width; ++i) {
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(data_[offset_ + i])) << (8 * i);
+    }
+    offset_ += width;
+    return true;
+  }
+
+  bool getString(std::string& value) {
+    uint64_t size;
+    if (!getUInt(size, 4) || size_ - offset_ < size) {
+      return false;
+    }
+    value.assign(data_ + offset_, size);
+    offset_ += size;
+    return true;
+  }
+
+  bool getBytes(const char*& data, size_t size) {
+    if (size_ - offset_ < size) {
+      return false;
+    }
+    data = data_ + offset_;
+    offset_ += size;
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+/**
+ * @brief A read-only memory mapping of a file which is unmapped on destruction.
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      munmap(data_, size_);
+    }
+  }
+
+  Status open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return Status(1, "Could not open snapshot " + path + ": " + std::strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      ::close(fd);
+      return Status(1, "Could not stat snapshot " + path + ": " + std::strerror(errno));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+      auto data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        ::close(fd);
+        return Status(1, "Could not map snapshot " + path + ": " + std::strerror(errno));
+      }
+      data_ = data;
+    }
+    ::close(fd);
+    return Status();
+  }
+
+  const char* data() const {
+    return static_cast<const char*>(data_);
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief Replace the file at path with data, such that after a crash the file
+ * holds either its old contents or all of data.
+ *
+ * The data is written to a uniquely named file next to path, which is flushed
+ * to disk before it is renamed over path, and the directory is flushed after
+ * the rename so that the rename itself is durable.
+ */
+Status writeDurably(const std::string& path, const std::string& data) {
+  auto tmp = path + ".XXXXXX";
+  int fd = mkstemp(&tmp[0]);
+  if (fd < 0) {
+    return Status(1, "Could not create snapshot " + tmp + ": " + std::strerror(errno));
+  }
+  auto fail = [&](const std::string& action) {
+    auto message = "Could not " + action + " snapshot " + tmp + ": " + std::strerror(errno);
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    ::unlink(tmp.c_str());
+    return Status(1, message);
+  };
+
+  size_t written = 0;
+  while (written < data.size()) {
+    auto n = ::write(fd, data.data() + written, data.size() - written);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0) {
+      return fail("write");
+    }
+    written += static_cast<size_t>(n);
+  }
+  if (::fsync(fd) != 0) {
+    return fail("sync");
+  }
+  auto closed = ::close(fd);
+  fd = -1;
+  if (closed != 0) {
+    return fail("close");
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    auto message = "Could not rename snapshot " + tmp + " to " + path + ": " + std::strerror(errno);
+    ::unlink(tmp.c_str());
+    return Status(1, message);
+  }
+
+  auto slash = path.rfind('/');
+  auto directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+  int dir_fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dir_fd < 0) {
+    return Status(1, "Could not open directory " + directory + ": " + std::strerror(errno));
+  }
+  auto synced = ::fsync(dir_fd);
+  auto error = errno;
+  ::close(dir_fd);
+  if (synced != 0) {
+    return Status(1, "Could not sync directory " + directory + ": " + std::strerror(error));
+  }
+  return Status();
+}
+} // namespace
+
+Status writeSnapshot(const std::string& path, const Snapshot& snapshot) {
+  Encoder e;
+  e.putBytes(kSnapshotMagic, sizeof(kSnapshotMagic));
+  e.putUInt(kSnapshotVersion, 4);
+  auto created = std::chrono::duration_cast<std::chrono::seconds>(snapshot.created.time_since_epoch());
+  e.putUInt(static_cast<uint64_t>(created.count()), 8);
+
+  e.putUInt(snapshot.assets.size(), 4);
+  for (const auto& asset : snapshot.assets) {
+    e.putString(asset.asset_class.toString());
+    e.putString(asset.exchange.toString());
+    e.putString(asset.id);
+    e.putString(asset.status.toString());
+    e.putString(asset.symbol.toString());
+    e.putUInt((asset.easy_to_borrow ? EasyToBorrowFlag : 0) | (asset.marginable ? MarginableFlag : 0) |
+                  (asset.shortable ? ShortableFlag : 0) | (asset.tradable ? TradableFlag : 0),
+              1);
+  }
+
+  e.putString(snapshot.calendar_start);
+  e.putString(snapshot.calendar_end);
+  e.putUInt(snapshot.calendar.size(), 4);
+  for (const auto& date : snapshot.calendar) {
+    e.putString(date.close);
+    e.putUInt(static_cast<uint64_t>(date.date.nanoseconds()), 8);
+    e.putString(date.open);
+  }
+
+  return writeDurably(path, e.buffer());
+}
+
+std::pair<Status, Snapshot> readSnapshot(const std::string& path) {
+  Snapshot snapshot;
+
+  MappedFile file;
+  if (auto s = file.open(path); !s.ok()) {
+    return std::make_pair(s, snapshot);
+  }
+
+  auto corrupt = [&]() {
+    return std::make_pair(Status(1, "Snapshot " + path + " is truncated or corrupt"), Snapshot());
+  };
+
+  Decoder d(file.data(), file.size());
+  const char* magic;
+  uint64_t version;
+  if (!d.getBytes(magic, sizeof(kSnapshotMagic)) || std::memcmp(magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+      !d.getUInt(version, 4)) {
+    return corrupt();
+  }
+  if (version != kSnapshotVersion) {
+    std::ostringstream ss;
+    ss << "Snapshot " << path << " has unsupported version " << version;
+    return std::make_pair(Status(1, ss.str()), snapshot);
+  }
+
+  uint64_t created;
+  if (!d.getUInt(created, 8)) {
+    return corrupt();
+  }
+  snapshot.created = std::chrono::system_clock::time_point(std::chrono::seconds(static_cast<int64_t>(created)));
+
+  uint64_t assets;
+  if (!d.getUInt(assets, 4)) {
+    return corrupt();
+  }
+  // Every asset takes at least 21 bytes, which bounds the reservation for a
+  // corrupt count.
+  snapshot.assets.reserve(std::min<uint64_t>(assets, file.size() / 21));
+  for (uint64_t i = 0; i < assets; ++i) {
+    Asset asset;
+    std::string asset_class, exchange, status, symbol;
+    uint64_t flags;
+    if (!d.getString(asset_class) || !d.getString(exchange) || !d.getString(asset.id) || !d.getString(status) ||
+        !d.getString(symbol) || !d.getUInt(flags, 1)) {
+      return corrupt();
+    }
+    asset.asset_class = Enum<AssetClass>::parse(asset_class.data(), asset_class.size());
+    asset.exchange = Enum<Exchange>::parse(exchange.data(), exchange.size());
+    asset.status = Enum<AssetStatus>::parse(status.data(), status.size());
+    asset.symbol = SymbolId::intern(symbol.data(), symbol.size());
+    asset.easy_to_borrow = flags & EasyToBorrowFlag;
+    asset.marginable = flags & MarginableFlag;
+    asset.shortable = flags & ShortableFlag;
+    asset.tradable = flags & TradableFlag;
+    snapshot.assets.push_back(std::move(asset));
+  }
+
+  uint64_t dates;
+  if (!d.getString(snapshot.calendar_start) || !d.getString(snapshot.calendar_end) || !d.getUInt(dates, 4)) {
+    return corrupt();
+  }
+  snapshot.calendar.reserve(std::min<uint64_t>(dates, file.size() / 16));
+  for (uint64_t i = 0; i < dates; ++i) {
+    Date date;
+    uint64_t nanoseconds;
+    if (!d.getString(date.close) || !d.getUInt(nanoseconds, 8) || !d.getString(date.open)) {
+      return corrupt();
+    }
+    date.date = Timestamp::fromNanoseconds(static_cast<int64_t>(nanoseconds));
+    snapshot.calendar.push_back(std::move(date));
+  }
+
+  return std::make_pair(Status(), snapshot);
+}
+} // namespace alpaca
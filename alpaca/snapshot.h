@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "alpaca/asset.h"
+#include "alpaca/calendar.h"
+#include "alpaca/status.h"
+
+namespace alpaca {
+
+/**
+ * @brief Reference data which is persisted between runs so that a client can
+ * start without waiting for the API.
+ */
+struct Snapshot {
+  /// When the data in the snapshot was fetched
+  std::chrono::system_clock::time_point created;
+
+  /// Every active US equity
+  std::vector<Asset> assets;
+
+  /// The trading calendar between calendar_start and calendar_end
+  std::string calendar_start;
+  std::string calendar_end;
+  std::vector<Date> calendar;
+};
+
+/**
+ * @brief Write a snapshot to a file in a compact binary format.
+ *
+ * The snapshot is written to a uniquely named temporary file which is synced
+ * to disk and then renamed over path, so readers and concurrent writers never
+ * see a partially written snapshot, and a crash leaves either the old or the
+ * new snapshot in place.
+ *
+ * @return a Status indicating the success or faliure of the operation.
+ */
+Status writeSnapshot(const std::string& path, const Snapshot& snapshot);
+
+/**
+ * @brief Read a snapshot written by writeSnapshot().
+ *
+ * The file is memory-mapped and decoded in place.
+ *
+ * @code{.cpp}
+ *   auto [status, snapshot] = alpaca::readSnapshot("/var/cache/alpaca.snapshot");
+ *   if (status.ok()) {
+ *     LOG(INFO) << "Loaded " << snapshot.assets.size() << " assets";
+ *   }
+ * @endcode
+ */
+std::pair<Status, Snapshot> readSnapshot(const std::string& path);
+} // namespace alpaca
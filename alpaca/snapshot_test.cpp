@@ -0,0 +1,121 @@
+#include "alpaca/snapshot.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class SnapshotTest : public ::testing::Test {};
+
+TEST_F(SnapshotTest, testRoundTrip) {
+  alpaca::Snapshot snapshot;
+  snapshot.created = std::chrono::system_clock::time_point(std::chrono::seconds(1588000000));
+  alpaca::Asset asset;
+  asset.asset_class = alpaca::AssetClass::USEquity;
+  asset.easy_to_borrow = true;
+  asset.exchange = alpaca::Enum<alpaca::Exchange>::parse("IEX", 3);
+  asset.id = "b0b6dd9d-8b9b-48a9-ba46-b9d54906e415";
+  asset.marginable = false;
+  asset.shortable = true;
+  asset.status = alpaca::AssetStatus::Active;
+  asset.symbol = "AAPL";
+  asset.tradable = true;
+  snapshot.assets.push_back(asset);
+  snapshot.calendar_start = "2020-01-01";
+  snapshot.calendar_end = "2020-12-31";
+  alpaca::Date date;
+  date.close = "16:00";
+  date.date = alpaca::Timestamp("2020-01-02");
+  date.open = "09:30";
+  snapshot.calendar.push_back(date);
+
+  auto path = ::testing::TempDir() + "/snapshot_round_trip";
+  ASSERT_TRUE(alpaca::writeSnapshot(path, snapshot).ok());
+  auto [status, read] = alpaca::readSnapshot(path);
+  std::remove(path.c_str());
+  ASSERT_TRUE(status.ok()) << status.getMessage();
+
+  EXPECT_EQ(read.created, snapshot.created);
+  ASSERT_EQ(read.assets.size(), 1);
+  EXPECT_EQ(read.assets[0].asset_class, alpaca::AssetClass::USEquity);
+  EXPECT_TRUE(read.assets[0].easy_to_borrow);
+  EXPECT_EQ(read.assets[0].exchange, alpaca::Exchange::Unknown);
+  EXPECT_EQ(read.assets[0].exchange.toString(), "IEX");
+  EXPECT_EQ(read.assets[0].id, "b0b6dd9d-8b9b-48a9-ba46-b9d54906e415");
+  EXPECT_FALSE(read.assets[0].marginable);
+  EXPECT_TRUE(read.assets[0].shortable);
+  EXPECT_EQ(read.assets[0].status, alpaca::AssetStatus::Active);
+  EXPECT_EQ(read.assets[0].symbol, "AAPL");
+  EXPECT_TRUE(read.assets[0].tradable);
+  EXPECT_EQ(read.calendar_start, "2020-01-01");
+  EXPECT_EQ(read.calendar_end, "2020-12-31");
+  ASSERT_EQ(read.calendar.size(), 1);
+  EXPECT_EQ(read.calendar[0].close, "16:00");
+  EXPECT_EQ(read.calendar[0].date, alpaca::Timestamp("2020-01-02"));
+  EXPECT_EQ(read.calendar[0].open, "09:30");
+}
+
+TEST_F(SnapshotTest, testMissingFile) {
+  auto path = ::testing::TempDir() + "/snapshot_missing";
+  EXPECT_FALSE(alpaca::readSnapshot(path).first.ok());
+}
+
+TEST_F(SnapshotTest, testTruncatedFile) {
+  alpaca::Snapshot snapshot;
+  alpaca::Asset asset;
+  asset.symbol = "AAPL";
+  snapshot.assets.push_back(asset);
+
+  auto path = ::testing::TempDir() + "/snapshot_truncated";
+  ASSERT_TRUE(alpaca::writeSnapshot(path, snapshot).ok());
+  std::string contents;
+  {
+    std::ifstream in(path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), contents.size() - 3);
+  }
+  EXPECT_FALSE(alpaca::readSnapshot(path).first.ok());
+  std::remove(path.c_str());
+}
+
+TEST_F(SnapshotTest, testReplaceSnapshot) {
+  auto directory = ::testing::TempDir() + "/snapshot_replace";
+  mkdir(directory.c_str(), 0700);
+  auto path = directory + "/snapshot";
+
+  alpaca::Snapshot snapshot;
+  snapshot.calendar_start = "2020-01-01";
+  ASSERT_TRUE(alpaca::writeSnapshot(path, snapshot).ok());
+  snapshot.calendar_start = "2021-01-01";
+  ASSERT_TRUE(alpaca::writeSnapshot(path, snapshot).ok());
+
+  auto [status, read] = alpaca::readSnapshot(path);
+  ASSERT_TRUE(status.ok()) << status.getMessage();
+  EXPECT_EQ(read.calendar_start, "2021-01-01");
+
+  // No temporary files are left behind.
+  std::vector<std::string> files;
+  auto dir = opendir(directory.c_str());
+  ASSERT_NE(dir, nullptr);
+  while (auto entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      files.push_back(entry->d_name);
+    }
+  }
+  closedir(dir);
+  EXPECT_EQ(files, std::vector<std::string>{"snapshot"});
+
+  std::remove(path.c_str());
+  rmdir(directory.c_str());
+}
@@ -1,5 +1,6 @@
 #include "streaming.h"
 
+#include "alpaca/parse_arena.h"
 #include "glog/logging.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
@@ -77,11 +78,12 @@ std::string MessageGenerator::listen(const std::set<StreamType>& streams) const
   return s.GetString();
 }
 
-std::pair<Status, Reply> parseReply(const std::string& text) {
+std::pair<Status, Reply> parseReply(std::string text) {
   Reply r;
 
-  rapidjson::Document d;
-  if (d.Parse(text.c_str()).HasParseError()) {
+  ParseArena arena;
+  auto& d = arena.document();
+  if (d.ParseInsitu(&text[0]).HasParseError()) {
     return std::make_pair(Status(1, "Received parse error when deserializing reply JSON"), r);
   }
 
@@ -144,7 +146,7 @@ Status Handler::run(Environment& env) {
   group->onMessage([this, listen](uWS::WebSocket<uWS::CLIENT>* ws, char* message, size_t length, uWS::OpCode opCode) {
     auto text = std::string(message, length);
 
-    auto parsed_reply = parseReply(text);
+    auto parsed_reply = parseReply(std::move(text));
     if (auto status = parsed_reply.first; !status.ok()) {
       LOG(ERROR) << "Error parsing stream reply: " << status.getMessage();
       return;
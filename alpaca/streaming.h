@@ -51,6 +51,10 @@ class MessageGenerator {
 
 /**
  * @brief A class for handling stream messages
+ *
+ * The callbacks are invoked on the thread which calls run(). To await stream
+ * messages from coroutines instead, run an alpaca::coro::StreamSource, which
+ * wraps a Handler (see alpaca/coroutine.h).
  */
 class Handler {
  public:
@@ -84,7 +88,10 @@ class Reply {
 
 /**
  * @brief Parse text from an Alpaca stream into a Reply object
+ *
+ * The text is parsed in situ, so move it in when it isn't needed afterwards
+ * to avoid copying it.
  */
-std::pair<Status, Reply> parseReply(const std::string& text);
+std::pair<Status, Reply> parseReply(std::string text);
 
 } // namespace alpaca::stream
\ No newline at end of file
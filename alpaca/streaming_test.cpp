@@ -51,4 +51,21 @@ const std::string kTradeUpdatsReply =
 
 class StreamingTest : public ::testing::Test {};
 
-TEST_F(StreamingTest, testReplyParser) {}
\ No newline at end of file
+TEST_F(StreamingTest, testReplyParser) {}
+
+TEST_F(StreamingTest, testParseReply) {
+  auto authorization = alpaca::stream::parseReply(kAuthorizationReply);
+  EXPECT_OK(authorization.first);
+  EXPECT_EQ(authorization.second.reply_type, alpaca::stream::Authorization);
+
+  // An lvalue is copied before it's parsed in situ, so it's left intact.
+  auto text = kTradeUpdatsReply;
+  auto update = alpaca::stream::parseReply(text);
+  EXPECT_OK(update.first);
+  EXPECT_EQ(text, kTradeUpdatsReply);
+  EXPECT_EQ(update.second.reply_type, alpaca::stream::Update);
+  EXPECT_EQ(update.second.stream_type, alpaca::stream::TradeUpdates);
+  EXPECT_NE(update.second.data.find("\"symbol\":\"AAPL\""), std::string::npos);
+
+  EXPECT_NOT_OK(alpaca::stream::parseReply("{\"stream\": ").first);
+}
@@ -0,0 +1,125 @@
+#include "alpaca/symbol.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace alpaca {
+
+namespace {
+/// The number of symbols in the first block of the table
+constexpr uint32_t kFirstBlockSize = 1024;
+
+/// Each block is twice the size of the one before, so this many cover every
+/// uint32_t id.
+constexpr size_t kBlocks = 23;
+
+/**
+ * @brief The interned symbols.
+ *
+ * Symbols are stored in blocks which are never moved or freed, so reading
+ * the symbol of an id is lock-free: whoever handed out the id published its
+ * block first. The index from symbol to id is guarded by a reader-writer
+ * lock, since nearly every lookup is of a symbol which is already interned.
+ */
+class SymbolTable {
+ public:
+  SymbolTable() {
+    add(std::string_view());
+  }
+
+  uint32_t intern(const std::string_view symbol) {
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      if (auto it = ids_.find(symbol); it != ids_.end()) {
+        return it->second;
+      }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (auto it = ids_.find(symbol); it != ids_.end()) {
+      return it->second;
+    }
+    return add(symbol);
+  }
+
+  const std::string& symbol(const uint32_t id) const {
+    auto [block, offset] = locate(id);
+    return blocks_[block].load(std::memory_order_acquire)[offset];
+  }
+
+  uint32_t count() const {
+    return count_.load(std::memory_order_acquire);
+  }
+
+ private:
+  /**
+   * @brief The block of an id and its offset in the block. Block b holds the
+   * ids from kFirstBlockSize * (2^b - 1) up to the next block.
+   */
+  static std::pair<size_t, size_t> locate(const uint32_t id) {
+    uint64_t n = id / kFirstBlockSize + 1;
+    auto block = static_cast<size_t>(63 - __builtin_clzll(n));
+    auto offset = id - kFirstBlockSize * ((uint64_t(1) << block) - 1);
+    return {block, static_cast<size_t>(offset)};
+  }
+
+  /**
+   * @brief Add a symbol, holding the exclusive lock.
+   */
+  uint32_t add(const std::string_view symbol) {
+    auto id = count_.load(std::memory_order_relaxed);
+    auto [block, offset] = locate(id);
+    auto storage = blocks_[block].load(std::memory_order_relaxed);
+    if (storage == nullptr) {
+      storage = new std::string[static_cast<size_t>(kFirstBlockSize) << block];
+      blocks_[block].store(storage, std::memory_order_release);
+    }
+    storage[offset].assign(symbol.data(), symbol.size());
+    ids_.emplace(storage[offset], id);
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+  }
+
+ private:
+  std::shared_mutex mutex_;
+  std::unordered_map<std::string_view, uint32_t> ids_;
+  std::atomic<std::string*> blocks_[kBlocks] = {};
+  std::atomic<uint32_t> count_{0};
+};
+
+/**
+ * @brief The table is never destroyed, so symbols stay valid in the
+ * destructors of other static objects.
+ */
+SymbolTable& symbolTable() {
+  static auto table = new SymbolTable();
+  return *table;
+}
+} // namespace
+
+SymbolId::SymbolId(const char* symbol) {
+  if (symbol != nullptr) {
+    *this = intern(symbol, std::strlen(symbol));
+  }
+}
+
+SymbolId::SymbolId(const std::string& symbol) : SymbolId(intern(symbol.data(), symbol.size())) {}
+
+SymbolId SymbolId::intern(const char* str, const size_t length) {
+  if (length == 0) {
+    return SymbolId();
+  }
+  return SymbolId(symbolTable().intern(std::string_view(str, length)));
+}
+
+uint32_t SymbolId::count() {
+  return symbolTable().count();
+}
+
+const std::string& SymbolId::toString() const {
+  return symbolTable().symbol(id_);
+}
+} // namespace alpaca
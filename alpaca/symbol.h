@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace alpaca {
+
+/**
+ * @brief A ticker symbol, interned in a table which is shared by the whole
+ * process.
+ *
+ * Every distinct symbol gets a dense integer id the first time it is seen,
+ * so models carry four bytes instead of a string, symbols compare as
+ * integers, and per-symbol state can be kept in an array indexed by id():
+ *
+ * @code{.cpp}
+ *   std::vector<alpaca::Decimal> exposure(alpaca::SymbolId::count());
+ *   for (const auto& position : positions) {
+ *     exposure[position.symbol.id()] += position.market_value;
+ *   }
+ *   LOG(INFO) << "AAPL exposure: " << exposure[alpaca::SymbolId("AAPL").id()];
+ * @endcode
+ *
+ * A SymbolId can be constructed from a string, and converts to one, so it
+ * can be used where either is expected. Interning is thread-safe, and
+ * reading the string of an id doesn't take a lock. Ids are never reused, so
+ * the table only grows.
+ */
+class SymbolId {
+ public:
+  /**
+   * @brief The empty symbol, whose id is zero.
+   */
+  SymbolId() = default;
+
+  SymbolId(const char* symbol);
+  SymbolId(const std::string& symbol);
+
+  /**
+   * @brief The id of a symbol, adding it to the table if it is new.
+   */
+  static SymbolId intern(const char* str, const size_t length);
+
+  /**
+   * @brief One more than the largest id, which is the size of an array that
+   * can be indexed by the id of every symbol seen so far.
+   */
+  static uint32_t count();
+
+  uint32_t id() const {
+    return id_;
+  }
+
+  bool empty() const {
+    return id_ == 0;
+  }
+
+  /**
+   * @brief The symbol, which stays valid for the lifetime of the process.
+   */
+  const std::string& toString() const;
+
+  operator const std::string&() const {
+    return toString();
+  }
+
+  /**
+   * @brief Symbols are ordered by id, which is the order they were first
+   * seen in rather than alphabetical order.
+   */
+  friend bool operator==(const SymbolId& lhs, const SymbolId& rhs) {
+    return lhs.id_ == rhs.id_;
+  }
+  friend bool operator!=(const SymbolId& lhs, const SymbolId& rhs) {
+    return lhs.id_ != rhs.id_;
+  }
+  friend bool operator<(const SymbolId& lhs, const SymbolId& rhs) {
+    return lhs.id_ < rhs.id_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const SymbolId& symbol) {
+    return os << symbol.toString();
+  }
+
+ private:
+  explicit SymbolId(const uint32_t id) : id_(id) {}
+
+  uint32_t id_ = 0;
+};
+} // namespace alpaca
+
+namespace std {
+template <>
+struct hash<alpaca::SymbolId> {
+  size_t operator()(const alpaca::SymbolId& symbol) const {
+    return std::hash<uint32_t>()(symbol.id());
+  }
+};
+} // namespace std
@@ -0,0 +1,88 @@
+#include "alpaca/symbol.h"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class SymbolTest : public ::testing::Test {};
+
+TEST_F(SymbolTest, testIntern) {
+  auto aapl = alpaca::SymbolId::intern("AAPL", 4);
+  EXPECT_FALSE(aapl.empty());
+  EXPECT_EQ(aapl.toString(), "AAPL");
+  EXPECT_EQ(alpaca::SymbolId("AAPL"), aapl);
+  EXPECT_EQ(alpaca::SymbolId(std::string("AAPL")).id(), aapl.id());
+  EXPECT_EQ(alpaca::SymbolId::intern("AAPLX", 4), aapl);
+  EXPECT_NE(alpaca::SymbolId("GOOG"), aapl);
+  EXPECT_LT(aapl.id(), alpaca::SymbolId::count());
+
+  std::string symbol = aapl;
+  EXPECT_EQ(symbol, "AAPL");
+  EXPECT_TRUE(aapl == "AAPL");
+  EXPECT_TRUE(aapl == symbol);
+
+  std::ostringstream ss;
+  ss << aapl;
+  EXPECT_EQ(ss.str(), "AAPL");
+}
+
+TEST_F(SymbolTest, testEmpty) {
+  EXPECT_TRUE(alpaca::SymbolId().empty());
+  EXPECT_EQ(alpaca::SymbolId().id(), 0);
+  EXPECT_EQ(alpaca::SymbolId().toString(), "");
+  EXPECT_EQ(alpaca::SymbolId(""), alpaca::SymbolId());
+  EXPECT_EQ(alpaca::SymbolId(static_cast<const char*>(nullptr)), alpaca::SymbolId());
+}
+
+TEST_F(SymbolTest, testDenseIds) {
+  auto count = alpaca::SymbolId::count();
+  std::vector<alpaca::SymbolId> symbols;
+  for (auto i = 0; i < 5000; ++i) {
+    symbols.emplace_back("DENSE" + std::to_string(i));
+  }
+  EXPECT_EQ(alpaca::SymbolId::count(), count + 5000);
+  for (auto i = 0; i < 5000; ++i) {
+    EXPECT_EQ(symbols[i].id(), count + i);
+    EXPECT_EQ(symbols[i].toString(), "DENSE" + std::to_string(i));
+  }
+}
+
+TEST_F(SymbolTest, testThreads) {
+  std::vector<std::vector<alpaca::SymbolId>> interned(8);
+  std::vector<std::thread> threads;
+  for (auto& symbols : interned) {
+    threads.emplace_back([&symbols]() {
+      for (auto i = 0; i < 2000; ++i) {
+        symbols.emplace_back("THREAD" + std::to_string(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<uint32_t> ids;
+  for (auto i = 0; i < 2000; ++i) {
+    for (const auto& symbols : interned) {
+      EXPECT_EQ(symbols[i], interned[0][i]);
+    }
+    EXPECT_EQ(interned[0][i].toString(), "THREAD" + std::to_string(i));
+    ids.insert(interned[0][i].id());
+  }
+  EXPECT_EQ(ids.size(), 2000);
+}
+
+TEST_F(SymbolTest, testHash) {
+  std::unordered_map<alpaca::SymbolId, int> counts;
+  counts["AAPL"]++;
+  counts["GOOG"]++;
+  counts[alpaca::SymbolId::intern("AAPL", 4)]++;
+  EXPECT_EQ(counts.size(), 2);
+  EXPECT_EQ(counts["AAPL"], 2);
+  EXPECT_EQ(counts["GOOG"], 1);
+}
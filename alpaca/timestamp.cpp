@@ -0,0 +1,260 @@
+#include "alpaca/timestamp.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace alpaca {
+
+namespace {
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+constexpr int64_t kSecondsPerDay = 24 * 60 * 60;
+
+/// The range of seconds whose nanoseconds fit in an int64_t, leaving out the
+/// value which marks an empty Timestamp
+constexpr int64_t kMinSeconds = INT64_MIN / kNanosecondsPerSecond + 1;
+constexpr int64_t kMaxSeconds = INT64_MAX / kNanosecondsPerSecond - 1;
+
+int64_t floorDivide(const int64_t a, const int64_t b) {
+  auto q = a / b;
+  return q - ((a % b) < 0);
+}
+
+/**
+ * @brief Read a fixed number of digits, setting bad instead of branching on
+ * each one.
+ */
+int64_t readDigits(const char* str, const size_t count, bool& bad) {
+  int64_t value = 0;
+  for (size_t i = 0; i < count; ++i) {
+    unsigned digit = static_cast<unsigned char>(str[i]) - '0';
+    bad |= digit > 9;
+    value = value * 10 + digit;
+  }
+  return value;
+}
+
+char* writeDigits(char* out, int64_t value, const size_t count) {
+  for (size_t i = count; i > 0; --i) {
+    out[i - 1] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  return out + count;
+}
+
+bool isLeapYear(const int64_t year) {
+  return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+int64_t daysInMonth(const int64_t year, const int64_t month) {
+  static constexpr int64_t kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return kDays[month - 1] + (month == 2 && isLeapYear(year));
+}
+
+/**
+ * @brief The number of days from 1970-01-01 to a date in the proleptic
+ * Gregorian calendar, from Howard Hinnant's chrono-compatible date algorithms.
+ */
+int64_t daysFromCivil(int64_t year, const int64_t month, const int64_t day) {
+  year -= month <= 2;
+  auto era = floorDivide(year, 400);
+  auto year_of_era = year - era * 400;
+  auto day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * @brief The inverse of daysFromCivil().
+ */
+void civilFromDays(int64_t days, int64_t& year, int64_t& month, int64_t& day) {
+  days += 719468;
+  auto era = floorDivide(days, 146097);
+  auto day_of_era = days - era * 146097;
+  auto year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  auto day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  auto shifted_month = (5 * day_of_year + 2) / 153;
+  day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+  month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+  year = year_of_era + era * 400 + (month <= 2);
+}
+
+/**
+ * @brief Write the date of a number of days since the epoch as YYYY-MM-DD.
+ */
+char* writeDate(char* out, const int64_t days) {
+  int64_t year, month, day;
+  civilFromDays(days, year, month, day);
+  out = writeDigits(out, year, 4);
+  *out++ = '-';
+  out = writeDigits(out, month, 2);
+  *out++ = '-';
+  return writeDigits(out, day, 2);
+}
+} // namespace
+
+Timestamp::Timestamp(const char* str) {
+  if (str == nullptr) {
+    return;
+  }
+  if (auto status = parse(str, std::strlen(str), *this); !status.ok()) {
+    throw std::invalid_argument(status.getMessage());
+  }
+}
+
+Timestamp::Timestamp(const std::string& str) {
+  if (auto status = parse(str.data(), str.size(), *this); !status.ok()) {
+    throw std::invalid_argument(status.getMessage());
+  }
+}
+
+Timestamp Timestamp::fromNanoseconds(const int64_t nanoseconds) {
+  Timestamp t;
+  t.nanoseconds_ = nanoseconds;
+  return t;
+}
+
+Timestamp Timestamp::fromSeconds(const int64_t seconds) {
+  return fromNanoseconds(seconds * kNanosecondsPerSecond);
+}
+
+Status Timestamp::parse(const char* str, const size_t length, Timestamp& out) {
+  if (length == 0) {
+    out = Timestamp();
+    return Status();
+  }
+  auto invalid = [&]() { return Status(1, "Couldn't parse \"" + std::string(str, length) + "\" as a timestamp"); };
+
+  // The date, and the time if there is one, are at fixed offsets.
+  if (length < 10 || str[4] != '-' || str[7] != '-') {
+    return invalid();
+  }
+  auto bad = false;
+  auto year = readDigits(str, 4, bad);
+  auto month = readDigits(str + 5, 2, bad);
+  auto day = readDigits(str + 8, 2, bad);
+  if (bad || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+    return invalid();
+  }
+  auto seconds = daysFromCivil(year, month, day) * kSecondsPerDay;
+  int64_t nanoseconds = 0;
+
+  if (length > 10) {
+    auto separator = str[10];
+    if ((separator != 'T' && separator != 't' && separator != ' ') || length < 19 || str[13] != ':' ||
+        str[16] != ':') {
+      return invalid();
+    }
+    auto hour = readDigits(str + 11, 2, bad);
+    auto minute = readDigits(str + 14, 2, bad);
+    auto second = readDigits(str + 17, 2, bad);
+    if (bad || hour > 23 || minute > 59 || second > 60) {
+      return invalid();
+    }
+    seconds += hour * 60 * 60 + minute * 60 + second;
+
+    size_t i = 19;
+    if (i < length && str[i] == '.') {
+      auto first = ++i;
+      for (int64_t place = kNanosecondsPerSecond / 10; i < length; ++i, place /= 10) {
+        unsigned digit = static_cast<unsigned char>(str[i]) - '0';
+        if (digit > 9) {
+          break;
+        }
+        nanoseconds += digit * place;
+      }
+      if (i == first) {
+        return invalid();
+      }
+    }
+
+    // A time without an offset is taken to be in UTC.
+    if (i < length && (str[i] == 'Z' || str[i] == 'z')) {
+      ++i;
+    } else if (i < length && (str[i] == '+' || str[i] == '-')) {
+      if (length - i < 6 || str[i + 3] != ':') {
+        return invalid();
+      }
+      auto offset_hours = readDigits(str + i + 1, 2, bad);
+      auto offset_minutes = readDigits(str + i + 4, 2, bad);
+      if (bad || offset_hours > 23 || offset_minutes > 59) {
+        return invalid();
+      }
+      auto offset = (offset_hours * 60 + offset_minutes) * 60;
+      seconds += str[i] == '-' ? offset : -offset;
+      i += 6;
+    }
+    if (i != length) {
+      return invalid();
+    }
+  }
+
+  if (seconds < kMinSeconds || seconds > kMaxSeconds) {
+    return Status(1, "Couldn't parse \"" + std::string(str, length) + "\" as a timestamp: it is out of range");
+  }
+  out.nanoseconds_ = seconds * kNanosecondsPerSecond + nanoseconds;
+  return Status();
+}
+
+int64_t Timestamp::seconds() const {
+  return floorDivide(nanoseconds_, kNanosecondsPerSecond);
+}
+
+std::string Timestamp::toString() const {
+  if (empty()) {
+    return "";
+  }
+  auto seconds = this->seconds();
+  auto nanoseconds = nanoseconds_ - seconds * kNanosecondsPerSecond;
+  auto days = floorDivide(seconds, kSecondsPerDay);
+  auto second_of_day = seconds - days * kSecondsPerDay;
+
+  char buffer[32];
+  auto p = writeDate(buffer, days);
+  *p++ = 'T';
+  p = writeDigits(p, second_of_day / (60 * 60), 2);
+  *p++ = ':';
+  p = writeDigits(p, second_of_day / 60 % 60, 2);
+  *p++ = ':';
+  p = writeDigits(p, second_of_day % 60, 2);
+  if (nanoseconds != 0) {
+    *p++ = '.';
+    if (nanoseconds % 1000000 == 0) {
+      p = writeDigits(p, nanoseconds / 1000000, 3);
+    } else if (nanoseconds % 1000 == 0) {
+      p = writeDigits(p, nanoseconds / 1000, 6);
+    } else {
+      p = writeDigits(p, nanoseconds, 9);
+    }
+  }
+  *p++ = 'Z';
+  return std::string(buffer, p);
+}
+
+std::string Timestamp::toDateString() const {
+  if (empty()) {
+    return "";
+  }
+  char buffer[16];
+  auto p = writeDate(buffer, floorDivide(seconds(), kSecondsPerDay));
+  return std::string(buffer, p);
+}
+
+Timestamp operator+(const Timestamp& lhs, const std::chrono::nanoseconds rhs) {
+  return lhs.empty() ? lhs : Timestamp::fromNanoseconds(lhs.nanoseconds_ + rhs.count());
+}
+
+Timestamp operator-(const Timestamp& lhs, const std::chrono::nanoseconds rhs) {
+  return lhs.empty() ? lhs : Timestamp::fromNanoseconds(lhs.nanoseconds_ - rhs.count());
+}
+
+std::chrono::nanoseconds operator-(const Timestamp& lhs, const Timestamp& rhs) {
+  if (lhs.empty() || rhs.empty()) {
+    return std::chrono::nanoseconds(0);
+  }
+  return std::chrono::nanoseconds(lhs.nanoseconds_ - rhs.nanoseconds_);
+}
+
+std::ostream& operator<<(std::ostream& os, const Timestamp& t) {
+  return os << t.toString();
+}
+} // namespace alpaca
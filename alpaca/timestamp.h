@@ -0,0 +1,139 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "alpaca/status.h"
+
+namespace alpaca {
+
+/**
+ * @brief An instant in time, kept as nanoseconds since the Unix epoch.
+ *
+ * The API sends times as RFC3339 strings such as "2018-10-05T05:48:59.123Z",
+ * and dates as strings such as "2018-10-05". Both are parsed once when a
+ * model is deserialized, so timestamps can be compared and sorted as
+ * integers. A date is the instant midnight UTC begins it.
+ *
+ Strings which may not be valid times, such as user input, are read with
+ * parse(), whose Status reports a bad one:
+ *
+ * @code{.cpp}
+ *   alpaca::Timestamp since;
+ *   if (auto status = alpaca::Timestamp::parse(input.data(), input.size(), since); !status.ok()) {
+ *     return status;
+ *   }
+ *   std::sort(orders.begin(), orders.end(), [](const alpaca::Order& a, const alpaca::Order& b) {
+ *     return a.submitted_at < b.submitted_at;
+ *   });
+ *   if (orders.back().submitted_at > since) {
+ *     auto resp = client.getOrders(alpaca::ActionStatus::All, 500, orders.back().submitted_at.toString());
+ *   }
+ * @endcode
+ *
+ * A default constructed Timestamp is empty, which stands for a time that is
+ * null or missing. Empty timestamps format as "", are equal to each other and
+ * order before every other time.
+ */
+class Timestamp {
+ public:
+  Timestamp() = default;
+
+  /**
+   * @brief Parse an RFC3339 timestamp or a date, such as a literal in the
+   * program.
+   *
+   * An empty string, or a null one, makes an empty Timestamp. Use parse() for
+   * strings which may not be valid times.
+   *
+   * @throws std::invalid_argument if str is not a timestamp or a date.
+   */
+  explicit Timestamp(const char* str);
+  explicit Timestamp(const std::string& str);
+
+  static Timestamp fromNanoseconds(const int64_t nanoseconds);
+  static Timestamp fromSeconds(const int64_t seconds);
+
+  /**
+   * @brief Parse an RFC3339 timestamp, such as "2020-04-01T09:30:00.5-04:00",
+   * or a date, such as "2020-04-01".
+   *
+   * The date and time may be separated by 'T', 't' or a space. Fractional
+   * seconds beyond nanoseconds are truncated. An empty string parses to an
+   * empty Timestamp.
+   *
+   * @return a Status indicating the success or faliure of the operation. On
+   * faliure, out is left unchanged.
+   */
+  static Status parse(const char* str, const size_t length, Timestamp& out);
+
+  /**
+   * @brief Whether the time is null or missing.
+   */
+  bool empty() const {
+    return nanoseconds_ == kEmpty;
+  }
+
+  int64_t nanoseconds() const {
+    return nanoseconds_;
+  }
+
+  /**
+   * @brief Whole seconds since the epoch, rounded down.
+   */
+  int64_t seconds() const;
+
+  /**
+   * @brief Format the time in UTC, such as "2018-10-05T05:48:59.123Z", for
+   * use in query parameters, or "" if it is empty.
+   *
+   * Fractional seconds are written as milli, micro or nanoseconds, whichever
+   * is the shortest exact form, and are left off when there are none.
+   */
+  std::string toString() const;
+
+  /**
+   * @brief Format the UTC date of the time, such as "2018-10-05", or "" if it
+   * is empty.
+   */
+  std::string toDateString() const;
+
+  /**
+   * @brief Shift a time, or find the time between two. Empty timestamps stay
+   * empty, and are no time apart from anything.
+   */
+  friend Timestamp operator+(const Timestamp& lhs, const std::chrono::nanoseconds rhs);
+  friend Timestamp operator-(const Timestamp& lhs, const std::chrono::nanoseconds rhs);
+  friend std::chrono::nanoseconds operator-(const Timestamp& lhs, const Timestamp& rhs);
+
+  friend bool operator==(const Timestamp& lhs, const Timestamp& rhs) {
+    return lhs.nanoseconds_ == rhs.nanoseconds_;
+  }
+  friend bool operator!=(const Timestamp& lhs, const Timestamp& rhs) {
+    return lhs.nanoseconds_ != rhs.nanoseconds_;
+  }
+  friend bool operator<(const Timestamp& lhs, const Timestamp& rhs) {
+    return lhs.nanoseconds_ < rhs.nanoseconds_;
+  }
+  friend bool operator<=(const Timestamp& lhs, const Timestamp& rhs) {
+    return lhs.nanoseconds_ <= rhs.nanoseconds_;
+  }
+  friend bool operator>(const Timestamp& lhs, const Timestamp& rhs) {
+    return lhs.nanoseconds_ > rhs.nanoseconds_;
+  }
+  friend bool operator>=(const Timestamp& lhs, const Timestamp& rhs) {
+    return lhs.nanoseconds_ >= rhs.nanoseconds_;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const Timestamp& t);
+
+ private:
+  /// Empty timestamps hold the smallest value so that they order first
+  static constexpr int64_t kEmpty = INT64_MIN;
+
+  int64_t nanoseconds_ = kEmpty;
+};
+} // namespace alpaca
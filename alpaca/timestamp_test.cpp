@@ -0,0 +1,84 @@
+#include "alpaca/timestamp.h"
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class TimestampTest : public ::testing::Test {};
+
+TEST_F(TimestampTest, testParse) {
+  alpaca::Timestamp t;
+  EXPECT_OK(alpaca::Timestamp::parse("2018-10-05T05:48:59Z", 20, t));
+  EXPECT_EQ(t.nanoseconds(), 1538718539000000000);
+  EXPECT_EQ(t.seconds(), 1538718539);
+
+  EXPECT_EQ(alpaca::Timestamp("2018-10-05T05:48:59.123456789Z").nanoseconds(), 1538718539123456789);
+  EXPECT_EQ(alpaca::Timestamp("2018-10-05t05:48:59.5z").nanoseconds(), 1538718539500000000);
+  EXPECT_EQ(alpaca::Timestamp("2018-10-05 05:48:59.1234567891234Z").nanoseconds(), 1538718539123456789);
+  EXPECT_EQ(alpaca::Timestamp("2020-04-01T09:30:00-04:00"), alpaca::Timestamp("2020-04-01T13:30:00Z"));
+  EXPECT_EQ(alpaca::Timestamp("2020-04-01T09:30:00+05:30"), alpaca::Timestamp("2020-04-01T04:00:00Z"));
+  EXPECT_EQ(alpaca::Timestamp("2020-04-01T09:30:00"), alpaca::Timestamp("2020-04-01T09:30:00Z"));
+  EXPECT_EQ(alpaca::Timestamp("2020-02-29"), alpaca::Timestamp("2020-02-29T00:00:00Z"));
+  EXPECT_EQ(alpaca::Timestamp("1969-12-31T23:59:59.9Z").nanoseconds(), -100000000);
+
+  EXPECT_OK(alpaca::Timestamp::parse("", 0, t));
+  EXPECT_TRUE(t.empty());
+
+  for (const std::string s : {"yesterday",
+                              "2018-10-05T",
+                              "2018-10-05T05:48",
+                              "2018-13-05",
+                              "2019-02-29",
+                              "2018-10-05T24:00:00Z",
+                              "2018-10-05T05:48:59.Z",
+                              "2018-10-05T05:48:59+0400",
+                              "2018-10-05T05:48:59Zjunk",
+                              "2018-1O-05",
+                              "2300-01-01"}) {
+    t = alpaca::Timestamp("2020-01-01");
+    EXPECT_NOT_OK(alpaca::Timestamp::parse(s.data(), s.size(), t));
+    EXPECT_EQ(t, alpaca::Timestamp("2020-01-01"));
+    EXPECT_THROW(alpaca::Timestamp{s}, std::invalid_argument);
+  }
+  EXPECT_TRUE(alpaca::Timestamp("").empty());
+  EXPECT_TRUE(alpaca::Timestamp(static_cast<const char*>(nullptr)).empty());
+}
+
+TEST_F(TimestampTest, testToString) {
+  for (const std::string s : {"2018-10-05T05:48:59Z",
+                              "2018-10-05T05:48:59.100Z",
+                              "2018-10-05T05:48:59.123456Z",
+                              "2018-10-05T05:48:59.000000001Z",
+                              "1969-12-31T23:59:59.900Z",
+                              "1970-01-01T00:00:00Z",
+                              "2262-04-11T23:47:15Z"}) {
+    EXPECT_EQ(alpaca::Timestamp(s).toString(), s);
+  }
+  EXPECT_EQ(alpaca::Timestamp("2020-04-01T09:30:00-04:00").toString(), "2020-04-01T13:30:00Z");
+  EXPECT_EQ(alpaca::Timestamp("2020-04-01T21:30:00-04:00").toDateString(), "2020-04-02");
+  EXPECT_EQ(alpaca::Timestamp().toString(), "");
+  EXPECT_EQ(alpaca::Timestamp().toDateString(), "");
+
+  std::ostringstream ss;
+  ss << alpaca::Timestamp("2020-02-29");
+  EXPECT_EQ(ss.str(), "2020-02-29T00:00:00Z");
+}
+
+TEST_F(TimestampTest, testArithmetic) {
+  auto t = alpaca::Timestamp("2020-04-01T13:30:00Z");
+  EXPECT_EQ(t + std::chrono::hours(24), alpaca::Timestamp("2020-04-02T13:30:00Z"));
+  EXPECT_EQ(t - std::chrono::milliseconds(1), alpaca::Timestamp("2020-04-01T13:29:59.999Z"));
+  EXPECT_EQ(alpaca::Timestamp("2020-04-01T16:00:00Z") - t, std::chrono::minutes(150));
+  EXPECT_TRUE((alpaca::Timestamp() + std::chrono::seconds(1)).empty());
+}
+
+TEST_F(TimestampTest, testCompare) {
+  EXPECT_LT(alpaca::Timestamp("2020-04-01T13:29:59.999Z"), alpaca::Timestamp("2020-04-01T09:30:00-04:00"));
+  EXPECT_GT(alpaca::Timestamp("2020-04-01"), alpaca::Timestamp("1969-07-20T20:17:40Z"));
+  EXPECT_LT(alpaca::Timestamp(), alpaca::Timestamp("1900-01-01"));
+  EXPECT_EQ(alpaca::Timestamp(), alpaca::Timestamp(""));
+}
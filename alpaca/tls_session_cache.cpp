@@ -0,0 +1,132 @@
+#include "alpaca/tls_session_cache.h"
+
+#include "glog/logging.h"
+
+namespace alpaca {
+
+/// The most sessions kept for each host
+const size_t kMaxSessionsPerHost = 8;
+
+namespace {
+int contextIndex() {
+  static int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
+/// Marks connections which have already been offered a session
+int connectionIndex() {
+  static int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
+std::string serverName(const SSL* ssl) {
+  auto name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+  return name ? name : "";
+}
+} // namespace
+
+namespace detail {
+int connectTLS(SSL* ssl) {
+  auto cache = TLSSessionCache::fromConnection(ssl);
+  if (cache != nullptr && SSL_get_ex_data(ssl, connectionIndex()) == nullptr) {
+    SSL_set_ex_data(ssl, connectionIndex(), cache);
+    if (auto session = cache->take(serverName(ssl))) {
+      // The connection takes its own reference to the session.
+      SSL_set_session(ssl, session);
+      SSL_SESSION_free(session);
+    }
+  }
+
+  auto result = SSL_connect(ssl);
+  if (cache != nullptr && result == 1) {
+    cache->handshakeDone(ssl);
+  }
+  return result;
+}
+} // namespace detail
+
+TLSSessionCache::~TLSSessionCache() {
+  clear();
+}
+
+void TLSSessionCache::install(SSL_CTX* ctx) {
+  if (ctx == nullptr) {
+    return;
+  }
+  SSL_CTX_set_ex_data(ctx, contextIndex(), this);
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ctx, &TLSSessionCache::onNewSession);
+}
+
+size_t TLSSessionCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sessions_.size();
+}
+
+void TLSSessionCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& entry : sessions_) {
+    for (auto session : entry.second) {
+      SSL_SESSION_free(session);
+    }
+  }
+  sessions_.clear();
+}
+
+size_t TLSSessionCache::resumedHandshakes() const {
+  return resumed_handshakes_;
+}
+
+size_t TLSSessionCache::fullHandshakes() const {
+  return full_handshakes_;
+}
+
+int TLSSessionCache::onNewSession(SSL* ssl, SSL_SESSION* session) {
+  auto cache = fromConnection(ssl);
+  auto host = serverName(ssl);
+  if (cache == nullptr || host.empty()) {
+    return 0;
+  }
+  if (SSL_get_ex_data(ssl, connectionIndex()) == nullptr) {
+    LOG_FIRST_N(WARNING, 1) << "A TLS connection to " << host << " was made without detail::connectTLS(), so "
+                            << "its sessions can't be resumed. Include httplib.h only through alpaca/http.h.";
+  }
+
+  // Returning 1 takes ownership of the reference to the session.
+  std::lock_guard<std::mutex> lock(cache->mutex_);
+  auto& cached = cache->sessions_[host];
+  cached.push_back(session);
+  if (cached.size() > kMaxSessionsPerHost) {
+    SSL_SESSION_free(cached.front());
+    cached.pop_front();
+  }
+  return 1;
+}
+
+TLSSessionCache* TLSSessionCache::fromConnection(const SSL* ssl) {
+  return static_cast<TLSSessionCache*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), contextIndex()));
+}
+
+SSL_SESSION* TLSSessionCache::take(const std::string& host) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = sessions_.find(host);
+  if (it == sessions_.end()) {
+    return nullptr;
+  }
+  auto session = it->second.back();
+  it->second.pop_back();
+  if (it->second.empty()) {
+    sessions_.erase(it);
+  }
+  return session;
+}
+
+void TLSSessionCache::handshakeDone(const SSL* ssl) {
+  if (SSL_session_reused(const_cast<SSL*>(ssl))) {
+    ++resumed_handshakes_;
+  } else {
+    DLOG(INFO) << "Full TLS handshake with " << serverName(ssl);
+    ++full_handshakes_;
+  }
+}
+} // namespace alpaca
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <openssl/ssl.h>
+
+namespace alpaca {
+
+namespace detail {
+/**
+ * @brief SSL_connect(), after setting a session from the TLSSessionCache
+ * installed on the connection's SSL_CTX, if there is one.
+ *
+ * The session is only set on the first call for a connection, so this can be
+ * called again to continue a non-blocking handshake.
+ */
+int connectTLS(SSL* ssl);
+} // namespace detail
+
+/**
+ * @brief Remembers TLS sessions per host so that new connections can resume
+ * them instead of performing a full handshake.
+ *
+ * cpp-httplib creates a new SSL_CTX for every client and offers no hook to
+ * set a session on a connection before it connects. install() registers a
+ * callback on a client's SSL_CTX which captures new sessions as they are
+ * issued, and alpaca/http.h routes cpp-httplib's calls to SSL_connect()
+ * through detail::connectTLS(), which sets a cached session for the server
+ * name of the connection before its handshake starts.
+ *
+ * Each cached session is handed to a single connection, since TLS 1.3
+ * session tickets should not be reused, and servers issue new ones on every
+ * connection.
+ *
+ * @code{.cpp}
+ *   auto sessions = alpaca::TLSSessionCache();
+ *   auto client = httplib::SSLClient("paper-api.alpaca.markets");
+ *   sessions.install(client.ssl_context());
+ * @endcode
+ */
+class TLSSessionCache {
+ public:
+  TLSSessionCache() = default;
+  TLSSessionCache(const TLSSessionCache&) = delete;
+  TLSSessionCache& operator=(const TLSSessionCache&) = delete;
+
+  ~TLSSessionCache();
+
+  /**
+   * @brief Resume and capture sessions for every connection made with ctx.
+   *
+   * The cache must outlive ctx.
+   */
+  void install(SSL_CTX* ctx);
+
+  /**
+   * @brief The number of hosts which have a session that can be resumed.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Forget every session.
+   */
+  void clear();
+
+  /**
+   * @brief The number of completed handshakes which resumed a session.
+   */
+  size_t resumedHandshakes() const;
+
+  /**
+   * @brief The number of completed handshakes which did not resume a session.
+   */
+  size_t fullHandshakes() const;
+
+ private:
+  friend int detail::connectTLS(SSL* ssl);
+
+  /**
+   * @brief Called by the SSL library when a new session has been established.
+   */
+  static int onNewSession(SSL* ssl, SSL_SESSION* session);
+
+  /**
+   * @brief The cache installed on the SSL_CTX of a connection.
+   */
+  static TLSSessionCache* fromConnection(const SSL* ssl);
+
+  /**
+   * @brief Remove the most recent session for a host from the cache.
+   *
+   * @return the session, which the caller must free, or nullptr if there is
+   * none.
+   */
+  SSL_SESSION* take(const std::string& host);
+
+  /**
+   * @brief Count a completed handshake.
+   */
+  void handshakeDone(const SSL* ssl);
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::deque<SSL_SESSION*>> sessions_;
+  std::atomic<size_t> resumed_handshakes_{0};
+  std::atomic<size_t> full_handshakes_{0};
+};
+} // namespace alpaca
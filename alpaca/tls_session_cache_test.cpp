@@ -0,0 +1,194 @@
+#include "alpaca/tls_session_cache.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include "alpaca/testing.h"
+#include "gtest/gtest.h"
+
+class TLSSessionCacheTest : public ::testing::Test {};
+
+namespace {
+/**
+ * @brief A TLS server on the loopback interface with a self-signed
+ * certificate, which answers each connection with a few bytes and closes it.
+ */
+class LocalTLSServer {
+ public:
+  explicit LocalTLSServer(int connections) {
+    EVP_PKEY* key = nullptr;
+    auto key_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    EVP_PKEY_keygen_init(key_ctx);
+    EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_ctx, NID_X9_62_prime256v1);
+    EVP_PKEY_keygen(key_ctx, &key);
+    EVP_PKEY_CTX_free(key_ctx);
+
+    auto cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    auto name = X509_get_subject_name(cert);
+    auto common_name = reinterpret_cast<const unsigned char*>("localhost");
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, common_name, -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_set_pubkey(cert, key);
+    X509_sign(cert, key, EVP_sha256());
+
+    ctx_ = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_use_certificate(ctx_, cert);
+    SSL_CTX_use_PrivateKey(ctx_, key);
+    X509_free(cert);
+    EVP_PKEY_free(key);
+
+    listener_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    listen(listener_, connections);
+    socklen_t length = sizeof(address);
+    getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    thread_ = std::thread([this, connections]() {
+      for (auto i = 0; i < connections; ++i) {
+        auto fd = accept(listener_, nullptr, nullptr);
+        auto ssl = SSL_new(ctx_);
+        SSL_set_fd(ssl, fd);
+        if (SSL_accept(ssl) == 1) {
+          SSL_write(ssl, "OK", 2);
+          SSL_shutdown(ssl);
+        }
+        SSL_free(ssl);
+        close(fd);
+      }
+    });
+  }
+
+  ~LocalTLSServer() {
+    thread_.join();
+    close(listener_);
+    SSL_CTX_free(ctx_);
+  }
+
+  int port() const {
+    return port_;
+  }
+
+ private:
+  SSL_CTX* ctx_;
+  int listener_;
+  int port_;
+  std::thread thread_;
+};
+
+/**
+ * @brief Connect to the server over a fresh SSL_CTX, as each cpp-httplib
+ * client does, and read its whole response.
+ *
+ * @return whether the handshake resumed a session, or -1 if it failed.
+ */
+int connectOnce(alpaca::TLSSessionCache& cache, int port) {
+  auto ctx = SSL_CTX_new(TLS_client_method());
+  cache.install(ctx);
+
+  auto fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  auto result = -1;
+  if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+    auto ssl = SSL_new(ctx);
+    SSL_set_tlsext_host_name(ssl, "localhost");
+    SSL_set_fd(ssl, fd);
+    if (alpaca::detail::connectTLS(ssl) == 1) {
+      // Reading the response also reads the session tickets which TLS 1.3
+      // servers send after the handshake.
+      char buffer[16];
+      while (SSL_read(ssl, buffer, sizeof(buffer)) > 0) {
+      }
+      result = SSL_session_reused(ssl);
+      // Sessions of connections which are not shut down cleanly can no
+      // longer be resumed.
+      SSL_shutdown(ssl);
+    }
+    SSL_free(ssl);
+  }
+  close(fd);
+  SSL_CTX_free(ctx);
+  return result;
+}
+} // namespace
+
+TEST_F(TLSSessionCacheTest, testInstall) {
+  alpaca::TLSSessionCache cache;
+  auto ctx = SSL_CTX_new(TLS_client_method());
+  ASSERT_NE(ctx, nullptr);
+  cache.install(ctx);
+  EXPECT_EQ(SSL_CTX_get_session_cache_mode(ctx) & SSL_SESS_CACHE_CLIENT, SSL_SESS_CACHE_CLIENT);
+  EXPECT_NE(SSL_CTX_sess_get_new_cb(ctx), nullptr);
+  SSL_CTX_free(ctx);
+
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.resumedHandshakes(), 0);
+  EXPECT_EQ(cache.fullHandshakes(), 0);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(TLSSessionCacheTest, testInstallIgnoresNullContext) {
+  alpaca::TLSSessionCache cache;
+  cache.install(nullptr);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(TLSSessionCacheTest, testResumesSessions) {
+  LocalTLSServer server(3);
+  alpaca::TLSSessionCache cache;
+
+  EXPECT_EQ(connectOnce(cache, server.port()), 0);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(connectOnce(cache, server.port()), 1);
+  EXPECT_EQ(connectOnce(cache, server.port()), 1);
+
+  EXPECT_EQ(cache.fullHandshakes(), 1);
+  EXPECT_EQ(cache.resumedHandshakes(), 2);
+}
+
+TEST_F(TLSSessionCacheTest, testSessionsAreNotShared) {
+  LocalTLSServer server(1);
+  alpaca::TLSSessionCache cache;
+  EXPECT_EQ(connectOnce(cache, server.port()), 0);
+
+  // Every session the server issued on the first connection is handed out
+  // once, after which there is nothing left to resume.
+  auto ctx = SSL_CTX_new(TLS_client_method());
+  cache.install(ctx);
+  std::vector<SSL*> connections;
+  while (cache.size() > 0) {
+    auto ssl = SSL_new(ctx);
+    SSL_set_tlsext_host_name(ssl, "localhost");
+    // The handshake fails without a socket, after the session has been set.
+    alpaca::detail::connectTLS(ssl);
+    EXPECT_NE(SSL_get_session(ssl), nullptr);
+    connections.push_back(ssl);
+  }
+  EXPECT_GE(connections.size(), 1);
+  for (size_t i = 1; i < connections.size(); ++i) {
+    EXPECT_NE(SSL_get_session(connections[i]), SSL_get_session(connections[0]));
+  }
+  for (auto ssl : connections) {
+    SSL_free(ssl);
+  }
+  SSL_CTX_free(ctx);
+}
@@ -1,52 +1,56 @@
 #include "alpaca/trade.h"
 
-#include "alpaca/json.h"
+#include "alpaca/parse_arena.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
 
 namespace alpaca {
-Status Trade::fromJSON(const std::string& json) {
-  rapidjson::Document d;
-  if (d.Parse(json.c_str()).HasParseError()) {
-    return Status(1, "Received parse error when deserializing trade JSON");
-  }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a trade object");
-  }
+namespace {
+constexpr auto kTradeSchema = makeSchema<Trade>("a trade",
+    {
+        {"price", &Trade::price},
+        {"size", &Trade::size},
+        {"exchange", &Trade::exchange},
+        {"cond1", &Trade::cond1},
+        {"cond2", &Trade::cond2},
+        {"cond3", &Trade::cond3},
+        {"cond4", &Trade::cond4},
+        {"timestamp", &Trade::timestamp},
+    });
+
+constexpr auto kLastTradeSchema = makeSchema<LastTrade>("a last trade",
+    {
+        {"status", &LastTrade::status},
+        {"symbol", &LastTrade::symbol},
+    });
+} // namespace
 
-  PARSE_DOUBLE(price, "price")
-  PARSE_INT(size, "size")
-  PARSE_INT(exchange, "exchange")
-  PARSE_INT(cond1, "cond1")
-  PARSE_INT(cond2, "cond2")
-  PARSE_INT(cond3, "cond3")
-  PARSE_INT(cond4, "cond4")
-  PARSE_UINT64(timestamp, "timestamp")
+Status Trade::fromJSON(const std::string& json) {
+  return kTradeSchema.parse(json.data(), json.size(), *this);
+}
 
-  return Status();
+Status Trade::fromDocument(const rapidjson::Value& d) {
+  return kTradeSchema.read(d, *this);
 }
 
 Status LastTrade::fromJSON(const std::string& json) {
-  rapidjson::Document d;
+  ParseArena arena;
+  auto& d = arena.document();
   if (d.Parse(json.c_str()).HasParseError()) {
     return Status(1, "Received parse error when deserializing last trade JSON");
   }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a last trade object");
-  }
+  return fromDocument(d);
+}
 
-  PARSE_STRING(status, "status")
-  PARSE_STRING(symbol, "symbol")
+Status LastTrade::fromDocument(const rapidjson::Value& d) {
+  if (auto status = kLastTradeSchema.read(d, *this); !status.ok()) {
+    return status;
+  }
 
   if (d.HasMember("last") && d["last"].IsObject()) {
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    d["last"].Accept(writer);
-    if (auto status = trade.fromJSON(s.GetString()); !status.ok()) {
+    if (auto status = trade.fromDocument(d["last"]); !status.ok()) {
       return status;
     }
   }
@@ -3,6 +3,8 @@
 #include <string>
 
 #include "alpaca/status.h"
+#include "alpaca/symbol.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
@@ -20,6 +22,16 @@ class Trade {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   double price;
   int size;
@@ -45,9 +57,19 @@ class LastTrade {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   std::string status;
-  std::string symbol;
+  SymbolId symbol;
   Trade trade;
 };
 } // namespace alpaca
\ No newline at end of file
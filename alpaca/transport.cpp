@@ -0,0 +1,389 @@
+#include "alpaca/transport.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "alpaca/hedge.h"
+#include "alpaca/retry.h"
+#include "glog/logging.h"
+
+namespace alpaca {
+
+const char* kJSONContentType = "application/json";
+
+/// How long requests are held back after an HTTP 429 without rate limit headers
+const std::chrono::seconds kTooManyRequestsBackoff = std::chrono::seconds(1);
+
+/// The number of recent latencies which hedging delays are computed from
+const size_t kLatencyWindow = 256;
+
+/// The number of latencies needed before the hedging percentile is trusted
+const size_t kMinLatencySamples = 20;
+
+namespace {
+long headerValue(const httplib::Response& response, const char* key, const long absent) {
+  if (!response.has_header(key)) {
+    return absent;
+  }
+  auto value = response.get_header_value(key);
+  char* end = nullptr;
+  auto parsed = std::strtol(value.c_str(), &end, 10);
+  return end == value.c_str() ? absent : parsed;
+}
+
+bool succeeded(const std::shared_ptr<httplib::Response>& response) {
+  return response && response->status >= 200 && response->status < 300;
+}
+} // namespace
+
+Transport::Transport(const Environment& environment,
+                     const ClientOptions& options,
+                     std::shared_ptr<Executor> executor)
+    : headers_({
+          {"APCA-API-KEY-ID", environment.getAPIKeyID()},
+          {"APCA-API-SECRET-KEY", environment.getAPISecretKey()},
+          {"Accept-Encoding", "identity"},
+      }),
+      compressed_headers_({
+          {"APCA-API-KEY-ID", environment.getAPIKeyID()},
+          {"APCA-API-SECRET-KEY", environment.getAPISecretKey()},
+          {"Accept-Encoding", "gzip, deflate"},
+      }),
+      compression_policy_(options.compression_policy),
+      coalesce_requests_(options.coalesce_requests),
+      trading_pool_(environment.getAPIBaseURL(), options, &tls_sessions_),
+      data_pool_(environment.getAPIDataURL(), options, &tls_sessions_),
+      rate_limiter_(options.rate_limit_per_minute),
+      retry_policy_(options.retry_policy),
+      executor_(std::move(executor)),
+      hedging_policy_(options.hedging_policy),
+      hedging_executor_(options.hedging_policy.threads),
+      trading_get_latencies_(kLatencyWindow),
+      trading_delete_latencies_(kLatencyWindow),
+      data_get_latencies_(kLatencyWindow) {}
+
+Transport::~Transport() {
+  if (!keep_warm_thread_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(keep_warm_->mutex);
+    keep_warm_->stopping = true;
+  }
+  keep_warm_->cv.notify_all();
+  if (keep_warm_thread_.get_id() == std::this_thread::get_id()) {
+    // The keep-warm thread held the last reference to the transport.
+    keep_warm_thread_.detach();
+  } else {
+    keep_warm_thread_.join();
+  }
+}
+
+std::shared_ptr<httplib::Response> Transport::Get(const APIHost host,
+                                                  const RequestPriority priority,
+                                                  const EndpointClass endpoint,
+                                                  const std::string& path,
+                                                  const bool hedgeable,
+                                                  bool* shared) {
+  if (!coalesce_requests_) {
+    if (shared != nullptr) {
+      *shared = false;
+    }
+    return fetch(host, priority, endpoint, path, hedgeable);
+  }
+
+  // Requests are only coalesced within a priority lane so that a high
+  // priority caller never waits on a request queued at a lower priority.
+  std::string key;
+  key.reserve(path.size() + 2);
+  key += static_cast<char>('0' + host);
+  key += static_cast<char>('0' + priority);
+  key += path;
+  return in_flight_.run(key, [&]() { return fetch(host, priority, endpoint, path, hedgeable); }, shared);
+}
+
+std::shared_ptr<httplib::Response> Transport::GetStreamed(const APIHost host,
+                                                          const RequestPriority priority,
+                                                          const EndpointClass endpoint,
+                                                          const std::string& path,
+                                                          const std::function<httplib::ContentReceiver()>& start) {
+  const auto& headers = headersFor(endpoint);
+  return send(host, priority, path, true, [&]() {
+    httplib::ContentReceiver receiver;
+    std::string body;
+    auto stopped = false;
+    auto resp = pool(host).Get(
+        path.c_str(),
+        headers,
+        [&](const httplib::Response& response) {
+          receiver = response.status == 200 ? start() : nullptr;
+          return true;
+        },
+        [&](const char* data, size_t length) {
+          if (receiver) {
+            stopped = !receiver(data, length);
+            return !stopped;
+          }
+          body.append(data, length);
+          return true;
+        });
+    if (stopped) {
+      // cpp-httplib reports a body which the receiver stopped reading as a
+      // failed request. Since it would only fail the same way again, the HTTP
+      // 200 is returned instead of retrying.
+      resp = std::make_shared<httplib::Response>();
+      resp->status = 200;
+    } else if (resp && !receiver) {
+      resp->body = std::move(body);
+    }
+    return resp;
+  });
+}
+
+std::shared_ptr<httplib::Response> Transport::Post(const APIHost host,
+                                                   const RequestPriority priority,
+                                                   const EndpointClass endpoint,
+                                                   const std::string& path,
+                                                   const std::string& body) {
+  const auto& headers = headersFor(endpoint);
+  return send(host, priority, path, false, [&]() {
+    return pool(host).Post(path.c_str(), headers, body, kJSONContentType);
+  });
+}
+
+std::shared_ptr<httplib::Response> Transport::Put(const APIHost host,
+                                                  const RequestPriority priority,
+                                                  const EndpointClass endpoint,
+                                                  const std::string& path,
+                                                  const std::string& body) {
+  const auto& headers = headersFor(endpoint);
+  return send(host, priority, path, false, [&]() {
+    return pool(host).Put(path.c_str(), headers, body, kJSONContentType);
+  });
+}
+
+std::shared_ptr<httplib::Response> Transport::Patch(const APIHost host,
+                                                    const RequestPriority priority,
+                                                    const EndpointClass endpoint,
+                                                    const std::string& path,
+                                                    const std::string& body) {
+  const auto& headers = headersFor(endpoint);
+  return send(host, priority, path, false, [&]() {
+    return pool(host).Patch(path.c_str(), headers, body, kJSONContentType);
+  });
+}
+
+std::shared_ptr<httplib::Response> Transport::Delete(const APIHost host,
+                                                     const RequestPriority priority,
+                                                     const EndpointClass endpoint,
+                                                     const std::string& path,
+                                                     const bool hedgeable) {
+  const auto& headers = headersFor(endpoint);
+  if (hedgeable && hedging_policy_.enabled && host == TradingHost) {
+    // The path is copied since the losing request of a hedge outlives this call.
+    Request request = [&headers, path](httplib::SSLClient& client) { return client.Delete(path.c_str(), headers); };
+    return send(host, priority, path, false, [&]() {
+      return sendHedged(host, priority, trading_delete_latencies_, request);
+    });
+  }
+  return send(host, priority, path, false, [&]() { return pool(host).Delete(path.c_str(), headers); });
+}
+
+RateLimiter& Transport::getRateLimiter() {
+  return rate_limiter_;
+}
+
+TLSSessionCache& Transport::getTLSSessionCache() {
+  return tls_sessions_;
+}
+
+size_t Transport::coalescedRequests() const {
+  return in_flight_.coalesced();
+}
+
+std::shared_ptr<httplib::Response> Transport::fetch(const APIHost host,
+                                                    const RequestPriority priority,
+                                                    const EndpointClass endpoint,
+                                                    const std::string& path,
+                                                    const bool hedgeable) {
+  const auto& headers = headersFor(endpoint);
+  if (hedgeable && hedging_policy_.enabled) {
+    auto& latencies = host == DataHost ? data_get_latencies_ : trading_get_latencies_;
+    // The path is copied since the losing request of a hedge outlives this call.
+    Request request = [&headers, path](httplib::SSLClient& client) { return client.Get(path.c_str(), headers); };
+    return send(host, priority, path, true, [&]() { return sendHedged(host, priority, latencies, request); });
+  }
+  return send(host, priority, path, true, [&]() { return pool(host).Get(path.c_str(), headers); });
+}
+
+size_t Transport::warmup(size_t connections) {
+  // Budget is taken before any connection is checked out, so that warming
+  // never waits for budget while holding connections which orders need. When
+  // the budget is tight, fewer connections are warmed.
+  size_t budget = 0;
+  while (budget < connections && rate_limiter_.tryAcquire(DataPriority)) {
+    ++budget;
+  }
+  if (budget < connections) {
+    DLOG(INFO) << "Only warming " << budget << " of " << connections << " connections for lack of budget";
+    connections = budget;
+  }
+  if (connections == 0) {
+    return 0;
+  }
+
+  const auto& headers = headersFor(ReferenceDataEndpoint);
+  return trading_pool_.warm(*executor_, connections, [this, &headers](httplib::SSLClient& client) {
+    auto resp = client.Get("/v2/clock", headers);
+    if (resp) {
+      observe(*resp);
+    }
+    return resp;
+  });
+}
+
+void Transport::startKeepWarm(const size_t connections, const std::chrono::seconds interval) {
+  if (keep_warm_thread_.joinable() || connections == 0 || interval.count() <= 0) {
+    return;
+  }
+
+  keep_warm_ = std::make_shared<KeepWarm>();
+  keep_warm_thread_ = std::thread([transport = weak_from_this(), state = keep_warm_, connections, interval]() {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        if (state->cv.wait_for(lock, interval, [&state]() { return state->stopping; })) {
+          return;
+        }
+      }
+      auto self = transport.lock();
+      if (!self) {
+        return;
+      }
+      self->warmup(connections);
+    }
+  });
+}
+
+template <typename F>
+std::shared_ptr<httplib::Response> Transport::send(const APIHost host,
+                                                   const RequestPriority priority,
+                                                   const std::string& path,
+                                                   const bool idempotent,
+                                                   const F& request) {
+  for (size_t attempt = 1;; ++attempt) {
+    rate_limiter_.acquire(priority);
+    auto resp = request();
+    if (resp) {
+      observe(*resp);
+    }
+
+    if (!idempotent || attempt >= retry_policy_.max_attempts || (resp && !isRetryableStatus(resp->status))) {
+      return resp;
+    }
+
+    auto delay = retryDelay(retry_policy_, attempt, resp ? resp->get_header_value("Retry-After") : "");
+    if (delay > retry_policy_.max_retry_after) {
+      return resp;
+    }
+
+    LOG(WARNING) << "Retrying call to " << path << " in " << delay.count() << "ms after "
+                 << (resp ? "an HTTP " + std::to_string(resp->status) : std::string("an empty response"));
+    std::this_thread::sleep_for(delay);
+  }
+}
+
+std::shared_ptr<httplib::Response> Transport::sendHedged(const APIHost host,
+                                                         const RequestPriority priority,
+                                                         LatencyTracker& latencies,
+                                                         const Request& request) {
+  auto delay = hedging_policy_.initial_delay;
+  if (latencies.samples() >= kMinLatencySamples) {
+    delay = std::chrono::duration_cast<std::chrono::milliseconds>(latencies.percentile(hedging_policy_.percentile));
+  }
+  delay = std::max(delay, hedging_policy_.min_delay);
+
+  // Each attempt keeps the transport alive, since a losing hedge is left to
+  // finish in the background.
+  auto call = [self = shared_from_this(), host, &latencies, request](HedgedAttempt& attempt) {
+    auto start = std::chrono::steady_clock::now();
+    auto resp = self->pool(host).execute([&](httplib::SSLClient& client) {
+      // Stopping the client makes the blocked request return, and the pool
+      // then discards the connection.
+      if (!attempt.onCancel([&client]() { client.stop(); })) {
+        return std::shared_ptr<httplib::Response>();
+      }
+      auto resp = request(client);
+      attempt.onCancel(nullptr);
+      return resp;
+    });
+    if (resp) {
+      latencies.record(
+          std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+    }
+    return resp;
+  };
+
+  return hedge<std::shared_ptr<httplib::Response>>(
+      hedging_executor_,
+      std::chrono::steady_clock::now() + delay,
+      // A hedge must not hold up requests which are waiting for budget.
+      [self = shared_from_this(), priority, delay]() {
+        if (!self->rate_limiter_.tryAcquire(priority)) {
+          return false;
+        }
+        DLOG(INFO) << "Hedging request after " << delay.count() << "ms";
+        return true;
+      },
+      call,
+      &succeeded);
+}
+
+void Transport::observe(const httplib::Response& response) {
+  auto limit = headerValue(response, "X-RateLimit-Limit", -1);
+  auto remaining = headerValue(response, "X-RateLimit-Remaining", -1);
+  auto reset = headerValue(response, "X-RateLimit-Reset", 0);
+
+  if (response.status == 429) {
+    LOG(WARNING) << "Request was rate limited by the API";
+    auto retry_after = headerValue(response, "Retry-After", -1);
+    if (retry_after >= 0) {
+      rate_limiter_.pause(std::chrono::steady_clock::now() + std::chrono::seconds(retry_after));
+    } else if (reset <= 0) {
+      rate_limiter_.pause(std::chrono::steady_clock::now() + kTooManyRequestsBackoff);
+    }
+    remaining = 0;
+  }
+
+  if (limit >= 0 || remaining >= 0) {
+    rate_limiter_.observe(limit, remaining, static_cast<std::time_t>(reset));
+  }
+}
+
+const httplib::Headers& Transport::headersFor(const EndpointClass endpoint) const {
+  bool compressed = false;
+  switch (endpoint) {
+  case TradingEndpoint:
+    compressed = compression_policy_.trading;
+    break;
+  case AccountActivityEndpoint:
+    compressed = compression_policy_.account_activity;
+    break;
+  case ReferenceDataEndpoint:
+    compressed = compression_policy_.reference_data;
+    break;
+  case MarketDataEndpoint:
+    compressed = compression_policy_.market_data;
+    break;
+  }
+  return compressed ? compressed_headers_ : headers_;
+}
+
+ConnectionPool& Transport::pool(const APIHost host) {
+  return host == DataHost ? data_pool_ : trading_pool_;
+}
+} // namespace alpaca
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "alpaca/config.h"
+#include "alpaca/connection_pool.h"
+#include "alpaca/executor.h"
+#include "alpaca/http.h"
+#include "alpaca/latency_tracker.h"
+#include "alpaca/rate_limiter.h"
+#include "alpaca/single_flight.h"
+#include "alpaca/tls_session_cache.h"
+
+namespace alpaca {
+
+/**
+ * @brief The API hosts which requests can be sent to.
+ */
+enum APIHost {
+  TradingHost,
+  DataHost,
+};
+
+/**
+ * @brief The classes of endpoints which CompressionPolicy switches
+ * compression on or off for.
+ */
+enum EndpointClass {
+  TradingEndpoint,
+  AccountActivityEndpoint,
+  ReferenceDataEndpoint,
+  MarketDataEndpoint,
+};
+
+/**
+ * @brief Sends every request made by a Client.
+ *
+ * The transport owns the connection pools for each API host along with the
+ * rate limiter which all requests go through, so policies which apply to every
+ * endpoint live here rather than in each Client method. Hedged requests may
+ * outlive the call which started them, so a Transport must be owned by a
+ * std::shared_ptr.
+ *
+ * @code{.cpp}
+ *   auto executor = std::make_shared<alpaca::Executor>(options.io_threads);
+ *   auto transport = std::make_shared<alpaca::Transport>(env, options, executor);
+ *   auto resp = transport->Get(alpaca::TradingHost, alpaca::AccountPriority, alpaca::TradingEndpoint, "/v2/account");
+ * @endcode
+ */
+class Transport : public std::enable_shared_from_this<Transport> {
+ public:
+  /**
+   * @brief The primary constructor.
+   *
+   * @param executor The client's I/O executor, which runs the requests that
+   * warm up connections.
+   */
+  Transport(const Environment& environment, const ClientOptions& options, std::shared_ptr<Executor> executor);
+
+  /**
+   * @brief The default constructor of Transport should never be used.
+   */
+  explicit Transport() = delete;
+
+  Transport(const Transport&) = delete;
+  Transport& operator=(const Transport&) = delete;
+
+  ~Transport();
+
+  /**
+   * @brief Send a GET request.
+   *
+   * GET requests are idempotent, so they are retried according to the
+   * client's RetryPolicy. Concurrent identical GET requests are coalesced into
+   * a single request whose response is shared, unless disabled by
+   * ClientOptions::coalesce_requests.
+   *
+   * @param hedgeable Whether the request may be hedged when the client's
+   * HedgingPolicy is enabled.
+   * @param shared If not null, set to whether the response was coalesced with
+   * another request. Only a caller whose response is not shared may modify it.
+   */
+  std::shared_ptr<httplib::Response> Get(const APIHost host,
+                                         const RequestPriority priority,
+                                         const EndpointClass endpoint,
+                                         const std::string& path,
+                                         const bool hedgeable = false,
+                                         bool* shared = nullptr);
+
+  /**
+   * @brief Send a GET request whose body is consumed as it arrives rather than
+   * buffered.
+   *
+   * For every attempt which returns an HTTP 200, start() is called and the
+   * body is passed in chunks to the receiver it returns, so a retried request
+   * starts consuming from scratch. The bodies of other responses are buffered
+   * in the returned response as usual so that they can be reported.
+   * Streamed requests are retried like any GET, but they are never coalesced
+   * or hedged since only one caller can consume a body. If the receiver
+   * returns false, the rest of the body is dropped along with the connection,
+   * and an HTTP 200 with an empty body is returned without retrying.
+   */
+  std::shared_ptr<httplib::Response> GetStreamed(const APIHost host,
+                                                 const RequestPriority priority,
+                                                 const EndpointClass endpoint,
+                                                 const std::string& path,
+                                                 const std::function<httplib::ContentReceiver()>& start);
+
+  /**
+   * @brief Send a POST request with a JSON body.
+   */
+  std::shared_ptr<httplib::Response> Post(const APIHost host,
+                                          const RequestPriority priority,
+                                          const EndpointClass endpoint,
+                                          const std::string& path,
+                                          const std::string& body);
+
+  /**
+   * @brief Send a PUT request with a JSON body.
+   */
+  std::shared_ptr<httplib::Response> Put(const APIHost host,
+                                         const RequestPriority priority,
+                                         const EndpointClass endpoint,
+                                         const std::string& path,
+                                         const std::string& body);
+
+  /**
+   * @brief Send a PATCH request with a JSON body.
+   */
+  std::shared_ptr<httplib::Response> Patch(const APIHost host,
+                                           const RequestPriority priority,
+                                           const EndpointClass endpoint,
+                                           const std::string& path,
+                                           const std::string& body);
+
+  /**
+   * @brief Send a DELETE request.
+   *
+   * @param hedgeable Whether the request may be hedged when the client's
+   * HedgingPolicy is enabled.
+   */
+  std::shared_ptr<httplib::Response> Delete(const APIHost host,
+                                            const RequestPriority priority,
+                                            const EndpointClass endpoint,
+                                            const std::string& path,
+                                            const bool hedgeable = false);
+
+  /**
+   * @brief The rate limiter which every request goes through.
+   */
+  RateLimiter& getRateLimiter();
+
+  /**
+   * @brief The number of GET requests which shared the response of an
+   * identical concurrent request.
+   */
+  size_t coalescedRequests() const;
+
+  /**
+   * @brief The TLS sessions which new connections resume.
+   */
+  TLSSessionCache& getTLSSessionCache();
+
+  /**
+   * @brief Open and exercise connections to the trading API host.
+   *
+   * Each connection sends a GET /v2/clock at the lowest priority. Warming
+   * never waits for budget: connections are only warmed while the rate limiter
+   * has budget to spare.
+   *
+   * @return the number of connections which are warm.
+   */
+  size_t warmup(size_t connections);
+
+  /**
+   * @brief Start a background thread which calls warmup() every interval.
+   *
+   * The thread only holds a weak reference to the transport, so it does not
+   * keep the transport alive.
+   */
+  void startKeepWarm(const size_t connections, const std::chrono::seconds interval);
+
+ private:
+  /**
+   * @brief Send a GET request without coalescing it.
+   */
+  std::shared_ptr<httplib::Response> fetch(const APIHost host,
+                                           const RequestPriority priority,
+                                           const EndpointClass endpoint,
+                                           const std::string& path,
+                                           const bool hedgeable);
+
+  /**
+   * @brief A request which can be sent over a pooled connection.
+   */
+  using Request = std::function<std::shared_ptr<httplib::Response>(httplib::SSLClient&)>;
+
+  /**
+   * @brief Make each attempt of a request once the rate limiter allows it.
+   *
+   * @param idempotent Whether the request may be retried after a failure.
+   * @param request Makes one attempt and returns its response.
+   */
+  template <typename F>
+  std::shared_ptr<httplib::Response> send(const APIHost host,
+                                          const RequestPriority priority,
+                                          const std::string& path,
+                                          const bool idempotent,
+                                          const F& request);
+
+  /**
+   * @brief Send a request, and a second one over another connection if the
+   * first is slower than usual.
+   *
+   * The first request is sent from the calling thread and only the hedge runs
+   * on the hedging executor. If the hedge succeeds first, the first request is
+   * interrupted.
+   *
+   * @return the first successful response, or the first response if neither
+   * succeeded.
+   */
+  std::shared_ptr<httplib::Response> sendHedged(const APIHost host,
+                                                const RequestPriority priority,
+                                                LatencyTracker& latencies,
+                                                const Request& request);
+
+  /**
+   * @brief Feed the rate limit headers of a response back to the rate limiter.
+   */
+  void observe(const httplib::Response& response);
+
+  /**
+   * @brief The request headers for the given class of endpoint.
+   *
+   * The headers ask for a compressed response if the CompressionPolicy
+   * enables it for the class.
+   */
+  const httplib::Headers& headersFor(const EndpointClass endpoint) const;
+
+  /**
+   * @brief The connection pool for the given host.
+   */
+  ConnectionPool& pool(const APIHost host);
+
+ private:
+  httplib::Headers headers_;
+  httplib::Headers compressed_headers_;
+  CompressionPolicy compression_policy_;
+  bool coalesce_requests_;
+  SingleFlight<std::shared_ptr<httplib::Response>> in_flight_;
+  /// Declared before the pools, since their connections refer to it
+  TLSSessionCache tls_sessions_;
+  ConnectionPool trading_pool_;
+  ConnectionPool data_pool_;
+  RateLimiter rate_limiter_;
+  RetryPolicy retry_policy_;
+
+  std::shared_ptr<Executor> executor_;
+  HedgingPolicy hedging_policy_;
+  Executor hedging_executor_;
+  LatencyTracker trading_get_latencies_;
+  LatencyTracker trading_delete_latencies_;
+  LatencyTracker data_get_latencies_;
+
+  /**
+   * @brief The state shared with the keep-warm thread.
+   */
+  struct KeepWarm {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+  };
+  std::shared_ptr<KeepWarm> keep_warm_;
+  std::thread keep_warm_thread_;
+};
+} // namespace alpaca
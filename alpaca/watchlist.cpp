@@ -1,39 +1,47 @@
 #include "alpaca/watchlist.h"
 
-#include "alpaca/json.h"
+#include "alpaca/parse_arena.h"
+#include "alpaca/schema.h"
 #include "rapidjson/document.h"
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
 
 namespace alpaca {
 
+namespace {
+constexpr auto kWatchlistSchema = makeSchema<Watchlist>("a watchlist",
+    {
+        {"account_id", &Watchlist::account_id},
+        {"created_at", &Watchlist::created_at},
+        {"id", &Watchlist::id},
+        {"name", &Watchlist::name},
+        {"updated_at", &Watchlist::updated_at},
+    });
+} // namespace
+
 Status Watchlist::fromJSON(const std::string& json) {
-  rapidjson::Document d;
+  ParseArena arena;
+  auto& d = arena.document();
   if (d.Parse(json.c_str()).HasParseError()) {
     return Status(1, "Received parse error when deserializing watchlist JSON");
   }
 
-  if (!d.IsObject()) {
-    return Status(1, "Deserialized valid JSON but it wasn't a watchlist object");
-  }
+  return fromDocument(d);
+}
 
-  PARSE_STRING(account_id, "account_id")
-  PARSE_STRING(created_at, "created_at")
-  PARSE_STRING(id, "id")
-  PARSE_STRING(name, "name")
-  PARSE_STRING(updated_at, "updated_at")
+Status Watchlist::fromDocument(const rapidjson::Value& d) {
+  if (auto status = kWatchlistSchema.read(d, *this); !status.ok()) {
+    return status;
+  }
 
   assets.clear();
-  for (auto& a : d["assets"].GetArray()) {
-    Asset asset;
-    rapidjson::StringBuffer s;
-    s.Clear();
-    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
-    a.Accept(writer);
-    if (auto status = asset.fromJSON(s.GetString()); !status.ok()) {
-      return status;
+  if (d.HasMember("assets") && d["assets"].IsArray()) {
+    assets.reserve(d["assets"].Size());
+    for (auto& a : d["assets"].GetArray()) {
+      Asset asset;
+      if (auto status = asset.fromDocument(a); !status.ok()) {
+        return status;
+      }
+      assets.push_back(asset);
     }
-    assets.push_back(asset);
   }
 
   return Status();
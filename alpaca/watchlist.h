@@ -5,6 +5,8 @@
 
 #include "alpaca/asset.h"
 #include "alpaca/status.h"
+#include "alpaca/timestamp.h"
+#include "rapidjson/document.h"
 
 namespace alpaca {
 
@@ -22,12 +24,22 @@ class Watchlist {
    */
   Status fromJSON(const std::string& json);
 
+  /**
+   * @brief A method for deserializing a parsed JSON value into the current
+   * object state.
+   *
+   * @param d The parsed JSON value
+   *
+   * @return a Status indicating the success or faliure of the operation.
+   */
+  Status fromDocument(const rapidjson::Value& d);
+
  public:
   std::string account_id;
   std::vector<Asset> assets;
-  std::string created_at;
+  Timestamp created_at;
   std::string id;
   std::string name;
-  std::string updated_at;
+  Timestamp updated_at;
 };
 } // namespace alpaca
\ No newline at end of file
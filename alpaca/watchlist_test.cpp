@@ -44,3 +44,18 @@ TEST_F(WatchlistTest, testWatchlistJSON) {
   EXPECT_OK(watchlist.fromJSON(kWatchlistJSON));
   EXPECT_EQ(watchlist.assets.size(), 2);
 }
+
+TEST_F(WatchlistTest, testWatchlistDocument) {
+  rapidjson::Document d;
+  ASSERT_FALSE(d.Parse(kWatchlistJSON.c_str()).HasParseError());
+  alpaca::Watchlist watchlist;
+  EXPECT_OK(watchlist.fromDocument(d));
+  ASSERT_EQ(watchlist.assets.size(), 2);
+  EXPECT_EQ(watchlist.assets[1].symbol, "AMZN");
+  EXPECT_FALSE(watchlist.assets[1].shortable);
+
+  alpaca::Asset asset;
+  EXPECT_OK(asset.fromDocument(d["assets"].GetArray()[0]));
+  EXPECT_EQ(asset.symbol, "SPY");
+  EXPECT_NOT_OK(asset.fromDocument(d["name"]));
+}
@@ -44,10 +44,9 @@ def alpaca_deps():
     if "com_github_yhirose_cpp-httplib" not in native.existing_rules():
         http_archive(
             name = "com_github_yhirose_cpp_httplib",
-            strip_prefix = "cpp-httplib-0.5.7",
-            urls = ["https://github.com/yhirose/cpp-httplib/archive/v0.5.7.tar.gz"],
+            strip_prefix = "cpp-httplib-0.7.0",
+            urls = ["https://github.com/yhirose/cpp-httplib/archive/v0.7.0.tar.gz"],
             build_file = "@//bazel/third_party/cpphttplib:BUILD",
-            sha256 = "27b7f6346bdeb1ead9d17bd7cea89d9ad491f50f0479081053cc6e5742a89e64",
         )
 
     # BoringSSL is a fork of OpenSSL that is designed to meet Google's needs.
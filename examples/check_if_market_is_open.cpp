@@ -36,7 +36,7 @@ int main(int argc, char* argv[]) {
     std::cerr << "Expected to receive 1 day result but got " << size << "instead." << std::endl;
   }
   auto day = days.front();
-  std::cout << "The market opened at " << day.open << " and closed at " << day.close << " on " << day.date << "."
-            << std::endl;
+  std::cout << "The market opened at " << day.open << " and closed at " << day.close << " on "
+            << day.date.toDateString() << "." << std::endl;
   return 0;
 }
\ No newline at end of file
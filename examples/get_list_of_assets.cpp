@@ -21,7 +21,7 @@ int main(int argc, char* argv[]) {
   // Filter the assets down to just those on NASDAQ.
   std::vector<alpaca::Asset> nasdaq_assets;
   for (const auto& asset : assets) {
-    if (asset.exchange == "NASDAQ") {
+    if (asset.exchange == alpaca::Exchange::NASDAQ) {
       nasdaq_assets.push_back(asset);
     }
   }
@@ -20,8 +20,12 @@ int main(int argc, char* argv[]) {
 
   // Submit a limit order to attempt to sell 1 share of AMD at a particular
   // price ($20.50) when the market opens
-  auto sell_response = client.submitOrder(
-      "AMD", 1, alpaca::OrderSide::Sell, alpaca::OrderType::Limit, alpaca::OrderTimeInForce::OPG, "20.50");
+  auto sell_response = client.submitOrder("AMD",
+                                          1,
+                                          alpaca::OrderSide::Sell,
+                                          alpaca::OrderType::Limit,
+                                          alpaca::OrderTimeInForce::OPG,
+                                          alpaca::Decimal("20.50"));
   if (auto status = sell_response.first; !status.ok()) {
     std::cerr << "Error submitting sell order: " << status.getMessage() << std::endl;
     return status.getCode();
@@ -16,8 +16,8 @@ int main(int argc, char* argv[]) {
                                          alpaca::OrderSide::Buy,
                                          alpaca::OrderType::Market,
                                          alpaca::OrderTimeInForce::Day,
-                                         "",
-                                         "",
+                                         alpaca::Decimal(),
+                                         alpaca::Decimal(),
                                          false,
                                          "my_first_order");
   if (auto status = buy_response.first; !status.ok()) {